@@ -139,6 +139,52 @@ void sgl_anim_remove(sgl_anim_t *anim)
 }
 
 
+/**
+ * @brief stop the animations whose data is an object of a subtree
+ * @param  obj root of subtree
+ * @return none
+ * @note   it must be called before the objects are freed, the animations that are freed
+ *         automatically are freed here, the others are still owned by application
+ */
+void sgl_anim_remove_obj(sgl_obj_t *obj)
+{
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_anim_t *anim = NULL, *next = NULL;
+    sgl_obj_t *root = obj;
+    int top = 0;
+
+    SGL_ASSERT(obj != NULL);
+    stack[top++] = obj;
+
+    while (top > 0 && anim_ctx.anim_cnt > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        for (anim = anim_ctx.anim_list_head; anim != NULL; anim = next) {
+            next = anim->next;
+            if (anim->data != obj) {
+                continue;
+            }
+
+            anim->finished = 1;
+            sgl_anim_remove(anim);
+            if (anim->auto_free) {
+                sgl_free(anim);
+            }
+        }
+
+        /* the siblings of root are not in the subtree */
+        if (obj != root && obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+    }
+}
+
+
 /**
  * @brief animation task, it will foreach all animation
  * @param  none
@@ -160,6 +206,7 @@ void sgl_anim_task(void)
         anim->act_time += sgl_tick_get();
 
         if(anim->act_time < anim->act_delay) {
+            anim = anim->next;
             continue;
         }
 
@@ -203,6 +250,32 @@ void sgl_anim_task(void)
 }
 
 
+/**
+ * @brief get the time until the next animation step
+ * @param  none
+ * @return 0 if any animation is running, the remaining delay of the nearest animation otherwise,
+ *         SGL_TASK_DEADLINE_IDLE if there is no animation
+ */
+uint32_t sgl_anim_next_deadline(void)
+{
+    uint32_t deadline = SGL_TASK_DEADLINE_IDLE, act_time = 0;
+    sgl_anim_t *anim = NULL;
+
+    sgl_anim_for_each(anim, &anim_ctx) {
+        /* the tick is added to the animations in next task */
+        act_time = anim->act_time + sgl_tick_get();
+
+        if (act_time >= anim->act_delay) {
+            return 0;
+        }
+
+        deadline = sgl_min(deadline, anim->act_delay - act_time);
+    }
+
+    return deadline;
+}
+
+
 /**
  * Linear animation path calculation function
  *
@@ -32,6 +32,9 @@
 #include <sgl_font.h>
 #include <sgl_theme.h>
 #include <sgl_misc.h>
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+#include <pthread.h>
+#endif
 
 
 /* current sgl system variable, do not used it */
@@ -59,9 +62,16 @@ static uint8_t sgl_mem_pool[CONFIG_SGL_HEAP_MEMORY_SIZE];
  */
 int sgl_fbdev_register(sgl_fbinfo_t *fbinfo)
 {
+    uint8_t fb_num = 0;
+
     sgl_check_ptr_return(fbinfo, -1);
 
-    if (fbinfo->buffer[0] == NULL) {
+    /* the draw buffers must be continuous from the first one */
+    while (fb_num < SGL_DRAW_BUFFER_MAX && fbinfo->buffer[fb_num] != NULL) {
+        fb_num ++;
+    }
+
+    if (fb_num == 0) {
         SGL_LOG_ERROR("You haven't set up the frame buffer.");
         SGL_ASSERT(0);
         return -1;
@@ -90,8 +100,11 @@ int sgl_fbdev_register(sgl_fbinfo_t *fbinfo)
     sgl_system.fbdev.surf.w = fbinfo->xres;
 
     sgl_system.tick_ms = 0;
-    sgl_system.fbdev.fb_status = 3;
-    sgl_system.fbdev.fb_swap = 0;
+
+    sgl_system.fbdev.fb_num = fb_num;
+    sgl_system.fbdev.fb_index = 0;
+    sgl_atomic_store(&sgl_system.fbdev.fb_submit, 0, relaxed);
+    sgl_atomic_store(&sgl_system.fbdev.fb_done, 0, relaxed);
 
     return 0;
 }
@@ -129,28 +142,174 @@ uint8_t sgl_pixmal_get_bytes_per_pixel(const sgl_pixmap_t *pixmap)
 }
 
 
+#if (CONFIG_SGL_OBJ_COMPACT)
 /**
- * @brief add object to parent
+ * @brief get the cold members of object, they are allocated if not yet
+ * @param obj: pointer of object
+ * @return pointer of cold members, NULL if out of memory
+ */
+sgl_obj_ext_t* sgl_obj_get_ext(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+
+    if (obj->ext == NULL) {
+        obj->ext = (sgl_obj_ext_t*)sgl_malloc_tagged(sizeof(sgl_obj_ext_t), SGL_MM_TAG_OBJECT);
+        if (obj->ext == NULL) {
+            SGL_LOG_ERROR("sgl_obj_get_ext: malloc failed");
+            return NULL;
+        }
+        memset(obj->ext, 0, sizeof(sgl_obj_ext_t));
+    }
+
+    return obj->ext;
+}
+#endif
+
+
+/**
+ * @brief get the last child of object
  * @param parent: pointer of parent object
+ * @return the last child, NULL if object has no child
+ */
+static inline sgl_obj_t* sgl_obj_child_tail(sgl_obj_t *parent)
+{
+    sgl_obj_t *tail = parent->child;
+
+    if (tail == NULL) {
+        return NULL;
+    }
+
+#if (CONFIG_SGL_OBJ_USE_PREV)
+    /* the first child points to the last child */
+    return tail->prev;
+#else
+    while (tail->sibling != NULL) {
+        tail = tail->sibling;
+    }
+
+    return tail;
+#endif
+}
+
+
+/**
+ * @brief get the previous sibling of object
+ * @param obj: pointer of object
+ * @return the previous sibling, NULL if object is the first child
+ */
+static inline sgl_obj_t* sgl_obj_sibling_prev(sgl_obj_t *obj)
+{
+    sgl_obj_t *prev = obj->parent->child;
+
+    if (prev == obj) {
+        return NULL;
+    }
+
+#if (CONFIG_SGL_OBJ_USE_PREV)
+    return obj->prev;
+#else
+    while (prev->sibling != obj) {
+        prev = prev->sibling;
+    }
+
+    return prev;
+#endif
+}
+
+
+/**
+ * @brief unlink object from the child list of its parent
  * @param obj: pointer of object
  * @return none
+ * @note the parent of object is kept
  */
-void sgl_obj_add_child(sgl_obj_t *parent, sgl_obj_t *obj)
+static void sgl_obj_unlink(sgl_obj_t *obj)
 {
-    SGL_ASSERT(parent != NULL && obj != NULL);
-    sgl_obj_t *tail = parent->child;
+    sgl_obj_t *parent = obj->parent;
+    sgl_obj_t *prev = sgl_obj_sibling_prev(obj);
+    sgl_obj_t *next = obj->sibling;
 
-    if (parent->child) {
-        while (tail->sibling != NULL) {
-            tail = tail->sibling;
-        };
-        tail->sibling = obj;
+    if (prev == NULL) {
+        parent->child = next;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+        /* the new first child inherits the tail link */
+        if (next != NULL) {
+            next->prev = obj->prev;
+        }
+#endif
     }
     else {
+        prev->sibling = next;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+        if (next != NULL) {
+            next->prev = prev;
+        }
+        else {
+            parent->child->prev = prev;
+        }
+#endif
+    }
+
+    obj->sibling = NULL;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+    obj->prev = NULL;
+#endif
+    sgl_obj_hit_invalidate();
+}
+
+
+/**
+ * @brief link object into the child list of parent
+ * @param parent: pointer of parent object
+ * @param prev: the sibling that object is linked after, NULL means the first child
+ * @param obj: pointer of object, it must be unlinked
+ * @return none
+ */
+static void sgl_obj_link_after(sgl_obj_t *parent, sgl_obj_t *prev, sgl_obj_t *obj)
+{
+    if (prev == NULL) {
+        obj->sibling = parent->child;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+        if (parent->child != NULL) {
+            obj->prev = parent->child->prev;
+            parent->child->prev = obj;
+        }
+        else {
+            obj->prev = obj;
+        }
+#endif
         parent->child = obj;
     }
+    else {
+        obj->sibling = prev->sibling;
+        prev->sibling = obj;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+        obj->prev = prev;
+        if (obj->sibling != NULL) {
+            obj->sibling->prev = obj;
+        }
+        else {
+            parent->child->prev = obj;
+        }
+#endif
+    }
 
     obj->parent = parent;
+    sgl_obj_hit_invalidate();
+}
+
+
+/**
+ * @brief add object to parent
+ * @param parent: pointer of parent object
+ * @param obj: pointer of object
+ * @return none
+ */
+void sgl_obj_add_child(sgl_obj_t *parent, sgl_obj_t *obj)
+{
+    SGL_ASSERT(parent != NULL && obj != NULL);
+
+    sgl_obj_link_after(parent, sgl_obj_child_tail(parent), obj);
 }
 
 
@@ -164,35 +323,141 @@ void sgl_obj_remove(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
 
-    sgl_obj_t *parent = obj->parent;
-    sgl_obj_t *pos = NULL;
+    sgl_obj_unlink(obj);
+}
+
+
+/* the pixels of translated objects are copied in VRAM instead of drawing them again */
+#define  SGL_BLIT_ENABLE   (CONFIG_SGL_USE_FBDEV_VRAM && CONFIG_SGL_TRANSLATE_NUM_MAX && CONFIG_SGL_DISPLAY_LIST_MAX)
+
+
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+/* the translated object is drawn again */
+#define  SGL_TRANSLATE_REDRAW              (0)
+/* the children are scrolled inside the solid view of object */
+#define  SGL_TRANSLATE_SCROLL              (1)
+/* the opaque object is moved with its children */
+#define  SGL_TRANSLATE_MOVE                (2)
 
-    if (parent->child != obj) {
-        pos = parent->child;
-        while (pos->sibling != obj) {
-            pos = pos->sibling;
+
+/**
+ * the pending translations of containers, when a container is moved or scrolled, only the offset
+ * is recorded here, the coords and areas of its descendants are updated once in dirty calculation
+ */
+static struct sgl_translate {
+    sgl_obj_t  *obj[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    int16_t    ofs_x[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    int16_t    ofs_y[CONFIG_SGL_TRANSLATE_NUM_MAX];
+#if (SGL_BLIT_ENABLE)
+    /* the offset of whole frame, it is not cleared by sgl_obj_coords_sync */
+    int16_t    blit_x[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    int16_t    blit_y[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    /* the area of object in framebuffer when the translation is recorded */
+    sgl_area_t area[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    sgl_area_t view[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    uint8_t    mode[CONFIG_SGL_TRANSLATE_NUM_MAX];
+#endif
+    uint8_t    num;
+} sgl_trans;
+
+
+/**
+ * @brief find the pending translation of object
+ * @param obj point to object
+ * @return index of translation, -1 if not found
+ */
+static inline int sgl_translate_find(sgl_obj_t *obj)
+{
+    for (int i = 0; i < sgl_trans.num; i++) {
+        if (sgl_trans.obj[i] == obj) {
+            return i;
         }
-        pos->sibling = obj->sibling;
     }
-    else {
-        parent->child = obj->sibling;
+
+    return -1;
+}
+
+
+/**
+ * @brief remove the pending translation
+ * @param index index of translation
+ * @return none
+ */
+static inline void sgl_translate_remove(int index)
+{
+    sgl_trans.num --;
+    sgl_trans.obj[index] = sgl_trans.obj[sgl_trans.num];
+    sgl_trans.ofs_x[index] = sgl_trans.ofs_x[sgl_trans.num];
+    sgl_trans.ofs_y[index] = sgl_trans.ofs_y[sgl_trans.num];
+#if (SGL_BLIT_ENABLE)
+    sgl_trans.blit_x[index] = sgl_trans.blit_x[sgl_trans.num];
+    sgl_trans.blit_y[index] = sgl_trans.blit_y[sgl_trans.num];
+    sgl_trans.area[index] = sgl_trans.area[sgl_trans.num];
+    sgl_trans.view[index] = sgl_trans.view[sgl_trans.num];
+    sgl_trans.mode[index] = sgl_trans.mode[sgl_trans.num];
+#endif
+}
+
+
+/**
+ * @brief add offset to the pending translation of object, a new translation is recorded if not found
+ * @param obj point to object
+ * @param ofs_x: x offset position
+ * @param ofs_y: y offset position
+ * @param mode: how the translated object is updated, the mixed modes fall back to redraw
+ * @return index of translation, -1 if there is no free translation slot
+ */
+static inline int sgl_translate_add(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y, uint8_t mode)
+{
+    int index = sgl_translate_find(obj);
+
+    if (index < 0) {
+        if (sgl_trans.num >= CONFIG_SGL_TRANSLATE_NUM_MAX) {
+            return -1;
+        }
+
+        index = sgl_trans.num ++;
+        sgl_trans.obj[index] = obj;
+        sgl_trans.ofs_x[index] = 0;
+        sgl_trans.ofs_y[index] = 0;
+#if (SGL_BLIT_ENABLE)
+        sgl_trans.blit_x[index] = 0;
+        sgl_trans.blit_y[index] = 0;
+        sgl_trans.area[index] = obj->area;
+        sgl_trans.mode[index] = mode;
+#endif
+    }
+#if (SGL_BLIT_ENABLE)
+    else if (sgl_trans.mode[index] != mode) {
+        sgl_trans.mode[index] = SGL_TRANSLATE_REDRAW;
     }
 
-    obj->sibling = NULL;
+    sgl_trans.blit_x[index] += ofs_x;
+    sgl_trans.blit_y[index] += ofs_y;
+#else
+    SGL_UNUSED(mode);
+#endif
+
+    sgl_trans.ofs_x[index] += ofs_x;
+    sgl_trans.ofs_y[index] += ofs_y;
+
+    return index;
 }
 
 
 /**
- * @brief move object child position
+ * @brief move all descendants of object without marking them dirty
  * @param obj point to object
  * @param ofs_x: x offset position
  * @param ofs_y: y offset position
+ * @param update_area: true to update the area of descendants, the area of obj must be updated
  * @return none
  */
-void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
+static void sgl_translate_walk(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y, bool update_area)
 {
-    SGL_ASSERT(obj != NULL);
 	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_obj_t *parent = NULL;
+    sgl_area_t fill_area;
     int top = 0;
 
     if (obj->child == NULL) {
@@ -200,16 +465,28 @@ void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
     }
     stack[top++] = obj->child;
 
+    if (ofs_x || ofs_y) {
+        sgl_obj_hit_invalidate();
+    }
+
     while (top > 0) {
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
-        obj->dirty = 1;
         obj->coords.x1 += ofs_x;
         obj->coords.x2 += ofs_x;
         obj->coords.y1 += ofs_y;
         obj->coords.y2 += ofs_y;
 
+        /* the parent is popped before its children, so its area is already updated */
+        if (update_area) {
+            parent = obj->parent;
+            fill_area = sgl_obj_get_fill_rect(parent);
+            if (parent->area.x1 > parent->area.x2 || !sgl_area_clip(&fill_area, &obj->coords, &obj->area)) {
+                sgl_area_init(&obj->area);
+            }
+        }
+
 		if (obj->sibling != NULL) {
 			stack[top++] = obj->sibling;
 		}
@@ -222,181 +499,340 @@ void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
 
 
 /**
- * @brief Set object absolute position
- * @param obj point to object
- * @param abs_x: x absolute position
- * @param abs_y: y absolute position
+ * @brief apply the pending translation of object, update the coords and areas of its descendants
+ * @param obj point to object, its area must be updated
  * @return none
  */
-void sgl_obj_set_abs_pos(sgl_obj_t *obj, int16_t abs_x, int16_t abs_y)
+static inline void sgl_translate_apply(sgl_obj_t *obj)
 {
-    SGL_ASSERT(obj != NULL);
-    int16_t x_diff = abs_x - obj->coords.x1;
-    int16_t y_diff = abs_y - obj->coords.y1;
+    int index = sgl_translate_find(obj);
 
-    obj->dirty = 1;
-    obj->coords.x1 += x_diff;
-    obj->coords.x2 += x_diff;
-    obj->coords.y1 += y_diff;
-    obj->coords.y2 += y_diff;
+    if (index < 0) {
+        return;
+    }
 
-    sgl_obj_move_child_pos(obj, x_diff, y_diff);
+    sgl_translate_walk(obj, sgl_trans.ofs_x[index], sgl_trans.ofs_y[index], true);
+    sgl_translate_remove(index);
 }
 
 
 /**
- * @brief zoom object size
- * @param obj point to object
- * @param zoom zoom size
+ * @brief flush the pending translations that are not applied in dirty calculation
+ * @param none
  * @return none
- * @note if you want to zoom out, the zoom should be positive, if you want to zoom in, the zoom should be negative
+ * @note the object or its ancestor is hidden or out of view, so the walk did not reach it, the
+ *       descendants are moved now and marked dirty, their areas are updated when they are visited
  */
-void sgl_obj_size_zoom(sgl_obj_t *obj, int16_t zoom)
+static void sgl_translate_flush(void)
 {
-    SGL_ASSERT(obj != NULL);
-    obj->coords.x1 -= zoom;
-    obj->coords.x2 += zoom;
-    obj->coords.y1 -= zoom;
-    obj->coords.y2 += zoom;
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_obj_t *obj;
+    int16_t ofs_x, ofs_y;
+    int top;
+
+    while (sgl_trans.num > 0) {
+        obj = sgl_trans.obj[0];
+        ofs_x = sgl_trans.ofs_x[0];
+        ofs_y = sgl_trans.ofs_y[0];
+        sgl_translate_remove(0);
+
+        /* the translated object is drawn again when it is visible */
+        sgl_obj_set_dirty(obj);
+        if (obj->child == NULL) {
+            continue;
+        }
+
+        obj->child_dirty = 1;
+        top = 0;
+        stack[top++] = obj->child;
+        sgl_obj_hit_invalidate();
+
+        while (top > 0) {
+            SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+            obj = stack[--top];
+
+            obj->coords.x1 += ofs_x;
+            obj->coords.x2 += ofs_x;
+            obj->coords.y1 += ofs_y;
+            obj->coords.y2 += ofs_y;
+            obj->dirty = 1;
+
+            if (obj->sibling != NULL) {
+                stack[top++] = obj->sibling;
+            }
+
+            if (obj->child != NULL) {
+                obj->child_dirty = 1;
+                stack[top++] = obj->child;
+            }
+        }
+    }
 }
 
 
 /**
- * @brief move object up a level layout
+ * @brief drop the pending translation of object that will be freed
  * @param obj point to object
  * @return none
- * @note Only move among sibling objects
  */
-void sgl_obj_move_up(sgl_obj_t *obj)
+static inline void sgl_translate_drop(sgl_obj_t *obj)
 {
-    SGL_ASSERT(obj != NULL);
-    sgl_obj_t *parent = obj->parent;
-    sgl_obj_t *prev = NULL;
-    sgl_obj_t *next = NULL;
-
-    /* if the object is the last child, do not move it */
-    if (obj->sibling == NULL) {
-        return;
-    }
-    else if (parent->child == obj) {
-        parent->child = obj->sibling;
-        obj->sibling = obj->sibling->sibling;
-        /* mark object as dirty */
-        sgl_obj_set_dirty(obj);
-        return;
-    }
+    int index = sgl_translate_find(obj);
 
-    /* move the object to its next sibling */
-    sgl_obj_for_each_child(prev, parent) {
-        if (prev->sibling == obj) {
-            next = obj->sibling;
-            obj->sibling = next->sibling;
-            prev->sibling = next;
-            next->sibling = obj;
-            /* mark object as dirty */
-            sgl_obj_set_dirty(obj);
-            return;
-        }
+    if (index >= 0) {
+        sgl_translate_remove(index);
     }
 }
+#endif
 
 
 /**
- * @brief move object down a level layout
- * @param obj point to object
+ * @brief update the coords of object that are moved by the pending translation of its ancestors
+ * @param obj point to object, NULL means all objects
  * @return none
- * @note Only move among sibling objects
+ * @note the area of descendants is still updated in next dirty calculation
  */
-void sgl_obj_move_down(sgl_obj_t *obj)
+void sgl_obj_coords_sync(sgl_obj_t *obj)
 {
-    SGL_ASSERT(obj != NULL);
-    sgl_obj_t *parent = obj->parent;
-    sgl_obj_t *prev = NULL;
-    sgl_obj_t *gprev = NULL;
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+    int i;
 
-    /* if the object is the first child, do not move it */
-    if (parent->child == obj || obj->sibling == NULL) {
+    if (sgl_trans.num == 0) {
         return;
     }
-    else if (parent->child->sibling == obj) {
-        parent->child->sibling = obj->sibling;
-        obj->sibling = parent->child;
-        parent->child = obj;
-        /* mark object as dirty */
-        sgl_obj_set_dirty(obj);
-        return;
-    }
-
-    /* move the object to its prev sibling */
-    sgl_obj_for_each_child(gprev, parent) {
-        prev = gprev->sibling;
 
-        if (prev->sibling == obj) {
-            prev->sibling = obj->sibling;
-            gprev->sibling = obj;
-            obj->sibling = prev;
-            /* mark object as dirty */
-            sgl_obj_set_dirty(obj);
+    /* only the translation of ancestors changes the coords of object */
+    while (obj != NULL) {
+        if (obj->parent == NULL || obj->parent == obj) {
             return;
         }
+
+        obj = obj->parent;
+        i = sgl_translate_find(obj);
+        if (i >= 0 && (sgl_trans.ofs_x[i] || sgl_trans.ofs_y[i])) {
+            break;
+        }
+    }
+
+    for (i = 0; i < sgl_trans.num; i++) {
+        sgl_translate_walk(sgl_trans.obj[i], sgl_trans.ofs_x[i], sgl_trans.ofs_y[i], false);
+        sgl_trans.ofs_x[i] = 0;
+        sgl_trans.ofs_y[i] = 0;
     }
+#else
+    SGL_UNUSED(obj);
+#endif
 }
 
 
 /**
- * @brief move object top level layout
+ * @brief move object child position
  * @param obj point to object
+ * @param ofs_x: x offset position
+ * @param ofs_y: y offset position
  * @return none
- * @note Only move among sibling objects
+ * @note the children are always inside the object, so only the object is marked dirty, and the
+ *       children are moved lazily in dirty calculation, if there is no free translation slot,
+ *       all children are moved and marked dirty immediately
  */
-void sgl_obj_move_top(sgl_obj_t *obj)
+void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
 {
-    SGL_ASSERT(obj != NULL && obj->parent != NULL);
-
-    sgl_obj_t *parent = obj->parent;
-    sgl_obj_t *prev = NULL, *curr = parent->child, *last = NULL;
+    SGL_ASSERT(obj != NULL);
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    int top = 0;
 
-    /* if the object is the last child, do not move it */
-    if (obj->sibling == NULL) {
+    if (obj->child == NULL || (ofs_x == 0 && ofs_y == 0)) {
         return;
     }
 
-    while (curr != NULL && curr != obj) {
-        prev = curr;
-        curr = curr->sibling;
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+    if (sgl_translate_add(obj, ofs_x, ofs_y, SGL_TRANSLATE_REDRAW) >= 0) {
+        sgl_obj_set_dirty(obj);
+        return;
     }
+#endif
 
-    if (prev == NULL) {
-        parent->child = obj->sibling;
+    /* all children will be dirty, so the dirty calculation must walk into this object */
+    obj->child_dirty = 1;
+    sgl_obj_set_child_dirty(obj);
+    sgl_obj_hit_invalidate();
+
+    stack[top++] = obj->child;
+
+    while (top > 0) {
+		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		obj = stack[--top];
+
+        obj->dirty = 1;
+        obj->child_dirty = 1;
+        obj->coords.x1 += ofs_x;
+        obj->coords.x2 += ofs_x;
+        obj->coords.y1 += ofs_y;
+        obj->coords.y2 += ofs_y;
+
+		if (obj->sibling != NULL) {
+			stack[top++] = obj->sibling;
+		}
+
+		if (obj->child != NULL) {
+			stack[top++] = obj->child;
+		}
     }
-    else {
-        prev->sibling = obj->sibling;
+}
+
+
+/**
+ * @brief scroll object child position inside a solid view of object
+ * @param obj point to object
+ * @param ofs_x: x offset position
+ * @param ofs_y: y offset position
+ * @param view: the area that object fills with one solid color under its children, NULL if none
+ * @return none
+ * @note the object is not marked dirty, the view is copied in framebuffer and the exposed part
+ *       is marked dirty in dirty calculation, it falls back to redraw if the copy is not safe
+ */
+void sgl_obj_scroll_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y, sgl_area_t *view)
+{
+    SGL_ASSERT(obj != NULL);
+
+#if (SGL_BLIT_ENABLE)
+    int index = -1;
+
+    if (obj->child == NULL || (ofs_x == 0 && ofs_y == 0)) {
+        return;
     }
 
-    last = parent->child;
-    if (last == NULL) {
-        parent->child = obj;
-        obj->sibling = NULL;
+    if (view != NULL && !sgl_obj_is_dirty(obj)) {
+        bool recorded = sgl_translate_find(obj) >= 0;
+
+        index = sgl_translate_add(obj, ofs_x, ofs_y, SGL_TRANSLATE_SCROLL);
+        if (index >= 0 && !recorded) {
+            sgl_trans.view[index] = *view;
+        }
+        else if (index >= 0 && !sgl_area_is_equal(&sgl_trans.view[index], view)) {
+            sgl_trans.mode[index] = SGL_TRANSLATE_REDRAW;
+        }
     }
-    else {
-        while (last->sibling != NULL) {
-            last = last->sibling;
+
+    if (index >= 0) {
+
+        if (sgl_trans.mode[index] == SGL_TRANSLATE_SCROLL) {
+            sgl_obj_set_child_dirty(obj);
+            return;
         }
-        last->sibling = obj;
-        obj->sibling = NULL;
+
+        sgl_obj_set_dirty(obj);
+        return;
     }
+#else
+    SGL_UNUSED(view);
+#endif
 
+    sgl_obj_move_child_pos(obj, ofs_x, ofs_y);
     sgl_obj_set_dirty(obj);
 }
 
 
 /**
- * @brief move object bottom level layout
+ * @brief Set object absolute position
+ * @param obj point to object
+ * @param abs_x: x absolute position
+ * @param abs_y: y absolute position
+ * @return none
+ * @note when the framebuffer is VRAM, an opaque object is copied to new position in framebuffer
+ */
+void sgl_obj_set_abs_pos(sgl_obj_t *obj, int16_t abs_x, int16_t abs_y)
+{
+    SGL_ASSERT(obj != NULL);
+    sgl_obj_coords_sync(obj);
+    int16_t x_diff = abs_x - obj->coords.x1;
+    int16_t y_diff = abs_y - obj->coords.y1;
+
+    if (x_diff || y_diff) {
+        sgl_obj_hit_invalidate();
+    }
+
+#if (SGL_BLIT_ENABLE)
+    if (sgl_obj_is_opaque(obj) && !sgl_obj_is_dirty(obj) && (x_diff || y_diff)) {
+        int index = sgl_translate_add(obj, x_diff, y_diff, SGL_TRANSLATE_MOVE);
+
+        if (index >= 0) {
+            obj->coords.x1 += x_diff;
+            obj->coords.x2 += x_diff;
+            obj->coords.y1 += y_diff;
+            obj->coords.y2 += y_diff;
+
+            if (sgl_trans.mode[index] == SGL_TRANSLATE_MOVE) {
+                sgl_obj_set_child_dirty(obj);
+            }
+            else {
+                sgl_obj_set_dirty(obj);
+            }
+            return;
+        }
+    }
+#endif
+
+    sgl_obj_set_dirty(obj);
+    obj->coords.x1 += x_diff;
+    obj->coords.x2 += x_diff;
+    obj->coords.y1 += y_diff;
+    obj->coords.y2 += y_diff;
+
+    sgl_obj_move_child_pos(obj, x_diff, y_diff);
+}
+
+
+/**
+ * @brief zoom object size
+ * @param obj point to object
+ * @param zoom zoom size
+ * @return none
+ * @note if you want to zoom out, the zoom should be positive, if you want to zoom in, the zoom should be negative
+ */
+void sgl_obj_size_zoom(sgl_obj_t *obj, int16_t zoom)
+{
+    SGL_ASSERT(obj != NULL);
+    obj->coords.x1 -= zoom;
+    obj->coords.x2 += zoom;
+    obj->coords.y1 -= zoom;
+    obj->coords.y2 += zoom;
+    sgl_obj_hit_invalidate();
+}
+
+
+/**
+ * @brief move object up a level layout
  * @param obj point to object
  * @return none
  * @note Only move among sibling objects
  */
-void sgl_obj_move_bottom(sgl_obj_t *obj)
+void sgl_obj_move_up(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    sgl_obj_t *next = obj->sibling;
+
+    /* if the object is the last child, do not move it */
+    if (next == NULL) {
+        return;
+    }
+
+    /* move the object after its next sibling */
+    sgl_obj_unlink(obj);
+    sgl_obj_link_after(next->parent, next, obj);
+
+    /* mark object as dirty */
+    sgl_obj_set_dirty(obj);
+}
+
+
+/**
+ * @brief move object down a level layout
+ * @param obj point to object
+ * @return none
+ * @note Only move among sibling objects
+ */
+void sgl_obj_move_down(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     sgl_obj_t *parent = obj->parent;
@@ -407,15 +843,59 @@ void sgl_obj_move_bottom(sgl_obj_t *obj)
         return;
     }
 
-    sgl_obj_for_each_child(prev, parent) {
-        if (prev->sibling == obj) {
-            break;
-        }
+    /* move the object before its prev sibling */
+    prev = sgl_obj_sibling_prev(obj);
+    sgl_obj_unlink(obj);
+    sgl_obj_link_after(parent, sgl_obj_sibling_prev(prev), obj);
+
+    /* mark object as dirty */
+    sgl_obj_set_dirty(obj);
+}
+
+
+/**
+ * @brief move object top level layout
+ * @param obj point to object
+ * @return none
+ * @note Only move among sibling objects
+ */
+void sgl_obj_move_top(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL && obj->parent != NULL);
+    sgl_obj_t *parent = obj->parent;
+
+    /* if the object is the last child, do not move it */
+    if (obj->sibling == NULL) {
+        return;
+    }
+
+    sgl_obj_unlink(obj);
+    sgl_obj_link_after(parent, sgl_obj_child_tail(parent), obj);
+
+    /* mark object as dirty */
+    sgl_obj_set_dirty(obj);
+}
+
+
+/**
+ * @brief move object bottom level layout
+ * @param obj point to object
+ * @return none
+ * @note Only move among sibling objects
+ */
+void sgl_obj_move_bottom(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    sgl_obj_t *parent = obj->parent;
+
+    /* if the object is the first child, do not move it */
+    if (parent->child == obj) {
+        return;
     }
 
-    prev->sibling = obj->sibling;
-    obj->sibling = parent->child;
-    parent->child = obj;
+    sgl_obj_unlink(obj);
+    sgl_obj_link_after(parent, NULL, obj);
+
     /* mark object as dirty */
     sgl_obj_set_dirty(obj);
 }
@@ -434,11 +914,18 @@ void sgl_obj_set_radius(sgl_obj_t *obj, size_t radius)
     int16_t h = (obj->coords.y2 - obj->coords.y1 + 1);
     int16_t d_min = w > h ? h : w;
 
+    /* the radius field is 10 bits wide and SGL_RADIUS_INVALID is reserved */
+    if (radius > SGL_RADIUS_INVALID - 1) {
+        SGL_LOG_WARN("sgl_obj_set_radius: radius %d is clamped to %d", (int)sgl_min(radius, INT16_MAX), SGL_RADIUS_INVALID - 1);
+        radius = SGL_RADIUS_INVALID - 1;
+    }
+
     if ((int16_t)radius >= (d_min / 2)) {
         radius = sgl_is_odd(d_min) ? d_min / 2 : (d_min - 1) / 2;
     }
 
-    obj->radius = radius & 0xFFF;
+    /* the opaque test also checks the radius, so the flag is left untouched here */
+    obj->radius = radius;
 }
 
 
@@ -458,11 +945,11 @@ void sgl_obj_print_name(sgl_obj_t *obj)
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
-        if (obj->name == NULL) {
+        if (sgl_obj_get_name(obj) == NULL) {
             SGL_LOG_INFO("[OBJ NAME]: %s", "NULL");
         }
         else {
-            SGL_LOG_INFO("[OBJ NAME]: %s", obj->name);
+            SGL_LOG_INFO("[OBJ NAME]: %s", sgl_obj_get_name(obj));
         }
 
 		if (obj->sibling != NULL) {
@@ -500,9 +987,7 @@ static void sgl_page_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
         }
     }
     else {
-        if (obj->event_fn) {
-            obj->event_fn(evt);
-        }
+        sgl_obj_call_event_cb(obj, evt);
     }
 }
 
@@ -542,7 +1027,7 @@ void sgl_page_set_pixmap(sgl_obj_t* obj, const sgl_pixmap_t *pixmap)
  */
 static sgl_page_t* sgl_page_create(void)
 {
-    sgl_page_t *page = sgl_malloc(sizeof(sgl_page_t));
+    sgl_page_t *page = sgl_slab_alloc(sizeof(sgl_page_t));
     if (page == NULL) {
         SGL_LOG_ERROR("sgl_page_create: malloc failed");
         return NULL;
@@ -555,7 +1040,7 @@ static sgl_page_t* sgl_page_create(void)
 
     if (sgl_system.fbdev.fbinfo.buffer[0] == NULL) {
         SGL_LOG_ERROR("sgl_page_create: framebuffer is NULL");
-        sgl_free(page);
+        sgl_slab_free(page);
         return NULL;
     }
 
@@ -566,6 +1051,7 @@ static sgl_page_t* sgl_page_create(void)
     obj->construct_fn = sgl_page_construct_cb;
     obj->dirty = 1;
     obj->page = 1;
+    obj->opaque = 1;
     obj->border = 0;
     obj->coords = (sgl_area_t) {
         .x1 = 0,
@@ -608,7 +1094,7 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
         return obj;
     }
     else {
-        obj = (sgl_obj_t*)sgl_malloc(sizeof(sgl_obj_t));
+        obj = (sgl_obj_t*)sgl_slab_alloc(sizeof(sgl_obj_t));
         if (obj == NULL) {
             SGL_LOG_ERROR("malloc failed");
             return NULL;
@@ -616,8 +1102,12 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
 
         obj->coords = parent->coords;
         obj->parent = parent;
+#if (CONFIG_SGL_OBJ_COMPACT)
+        obj->ext = NULL;
+#else
         obj->event_fn = NULL;
         obj->event_data = 0;
+#endif
         obj->construct_fn = NULL;
         obj->dirty = 1;
 
@@ -625,6 +1115,7 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
         sgl_obj_node_init(obj);
         /* add the child into parent's child list */
         sgl_obj_add_child(parent, obj);
+        sgl_obj_set_child_dirty(obj);
 
         return obj;
     }
@@ -643,6 +1134,9 @@ static inline void sgl_dirty_area_init(void)
 
 
 void vispect_boot_logo(void);
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+static int sgl_render_pool_init(void);
+#endif
 /**
  * @brief sgl global initialization
  * @param none
@@ -683,10 +1177,15 @@ int sgl_init(void)
     /* create event queue */
     if (sgl_event_queue_init()) {
         SGL_LOG_ERROR("sgl_init: event queue init failed");
-        sgl_free(obj);
+        sgl_slab_free(obj);
         return -1;
     }
 
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+    /* start render workers, if failed, all slices are drawn by current thread */
+    sgl_render_pool_init();
+#endif
+
     sgl_obj_delete_sync(NULL);
 #if (CONFIG_SGL_BOOT_LOGO)
     // sgl_boot_logo();
@@ -794,136 +1293,315 @@ bool sgl_area_selfclip(sgl_area_t *clip, sgl_area_t *area)
 
 
 /**
- * @brief Computes the total boundary expansion (in Manhattan distance) required to merge rectangle b into rectangle a.
- *
- * @param a[in]    Pointer to the b rectangle
- * @param b[in]    Pointer to the a rectangle
- * @return int32_t Total expansion amount (always non-negative)
+ * @brief get the pixel number of an area
+ * @param area [in] Pointer to the area
+ * @return uint32_t pixel number
+ */
+static inline uint32_t sgl_area_pixels(sgl_area_t *area)
+{
+    return (uint32_t)(area->x2 - area->x1 + 1) * (uint32_t)(area->y2 - area->y1 + 1);
+}
+
+
+/**
+ * @brief get the pixel number of the intersection of two areas
+ * @param a [in] Pointer to the first area
+ * @param b [in] Pointer to the second area
+ * @return uint32_t pixel number, 0 if two areas are not overlapped
  */
-static inline int32_t sgl_area_growth(sgl_area_t *a, sgl_area_t *b)
+static inline uint32_t sgl_area_overlap_pixels(sgl_area_t *a, sgl_area_t *b)
 {
-    return (a->x1 - sgl_min(a->x1, b->x1)) + (sgl_max(a->x2, b->x2) - a->x2)
-           + (a->y1 - sgl_min(a->y1, b->y1)) + (sgl_max(a->y2, b->y2) - a->y2);
+    sgl_area_t clip;
+
+    if (!sgl_area_clip(a, b, &clip)) {
+        return 0;
+    }
+
+    return sgl_area_pixels(&clip);
 }
 
 
 /**
- * @brief Quickly determines if two rectangles are close enough to be merged.
+ * @brief Computes the merge cost of two areas in pixels
  *
- * This fast heuristic is useful in performance-critical contexts (e.g., real-time segmentation or region merging)
- * to avoid excessive fragmentation while preventing merges between distant regions.
+ * The cost is the number of pixels that would be redrawn but are not damaged, if the two areas
+ * are replaced by their bounding box.
  *
- * @param a[in] Pointer to the first rectangle
- * @param b[in] Pointer to the second rectangle
- * @return bool true if the rectangles are sufficiently close for merging; false otherwise
+ * @param a [in] Pointer to the first area
+ * @param b [in] Pointer to the second area
+ * @return uint32_t number of wasted pixels
  */
-static inline bool sgl_merge_determines(sgl_area_t* a, sgl_area_t* b)
+static inline uint32_t sgl_area_merge_cost(sgl_area_t *a, sgl_area_t *b)
 {
-    int16_t gap_x = (a->x1 > b->x2) ? (a->x1 - b->x2) : (b->x1 > a->x2) ? (b->x1 - a->x2) : 0;
-    int16_t gap_y = (a->y1 > b->y2) ? (a->y1 - b->y2) : (b->y1 > a->y2) ? (b->y1 - a->y2) : 0;    
-    int16_t threshold = (sgl_min4(a->x2 - a->x1 + 1, a->y2 - a->y1 + 1, b->x2 - b->x1 + 1, b->y2 - b->y1 + 1) >> 2);
+    sgl_area_t merge;
 
-    return (gap_x <= threshold) && (gap_y <= threshold);
+    sgl_area_merge(a, b, &merge);
+
+    return sgl_area_pixels(&merge) - sgl_area_pixels(a) - sgl_area_pixels(b) + sgl_area_overlap_pixels(a, b);
 }
 
 
 /**
- * @brief merge an area into global dirty area
- * 
- * This function calculates how much rectangle 'a' would need to grow in each direction (left, right, top, bottom)
- * to fully enclose both 'a' and 'b'. The result is the sum of the expansions along all four sides.
- * Note: This is not the increase in area, th is a lightweight heuristic for merge cost in bounding-box algorithms.
- * 
- * @param area [in] Pointer to the area
- * @return none
+ * @brief subtract area b from area a, the rest of area a is split into y-banded pieces
+ *
+ *      +-----------------+
+ *      |      top        |
+ *      +-----+-----+-----+
+ *      |left |  b  |right|
+ *      +-----+-----+-----+
+ *      |     bottom      |
+ *      +-----------------+
+ *
+ * @param a [in] Pointer to the area to be subtracted
+ * @param b [in] Pointer to the area to subtract, it must overlap area a
+ * @param out [out] pieces of area a that are not covered by area b, at most 4 pieces
+ * @return int number of pieces
  */
-void sgl_dirty_area_push(sgl_area_t *area)
+static int sgl_area_subtract(sgl_area_t *a, sgl_area_t *b, sgl_area_t out[4])
 {
-    SGL_ASSERT(area != NULL);
-    int32_t best_idx = -1, min_growth = INT32_MAX, growth = INT32_MAX;
-    /* skip invalid area */
-    if (area->x1 > area->x2 || area->y1 > area->y2) {
-        return;
-    }
+    int num = 0;
+    int16_t y1 = sgl_max(a->y1, b->y1);
+    int16_t y2 = sgl_min(a->y2, b->y2);
 
-    if (sgl_system.fbdev.dirty_num == 0) {
-        sgl_system.fbdev.dirty[0] = *area;
-        sgl_system.fbdev.dirty_num = 1;
-        return;
+    if (a->y1 < b->y1) {
+        out[num++] = (sgl_area_t){ .x1 = a->x1, .y1 = a->y1, .x2 = a->x2, .y2 = b->y1 - 1 };
     }
-
-    for (uint8_t i = 0; i < sgl_system.fbdev.dirty_num; i++) {
-        if (sgl_merge_determines(&sgl_system.fbdev.dirty[i], area)) {
-            growth = sgl_area_growth(&sgl_system.fbdev.dirty[i], area);
-            if (growth == 0) {
-                /* already contains the area */
-                return;
-            }
-            else if (growth < min_growth) {
-                min_growth = growth;
-                best_idx = i;
-            }
-        }
+    if (a->x1 < b->x1) {
+        out[num++] = (sgl_area_t){ .x1 = a->x1, .y1 = y1, .x2 = b->x1 - 1, .y2 = y2 };
     }
-
-    if (best_idx >= 0) {
-        /* merge object area into best_idx dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[best_idx], area);
-        return;
+    if (a->x2 > b->x2) {
+        out[num++] = (sgl_area_t){ .x1 = b->x2 + 1, .y1 = y1, .x2 = a->x2, .y2 = y2 };
     }
-
-    if (sgl_system.fbdev.dirty_num < SGL_DIRTY_AREA_NUM_MAX) {
-        /* add new dirty area */
-        sgl_system.fbdev.dirty[sgl_system.fbdev.dirty_num++] = *area;
-    } else {
-        /* merge object area into last dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[SGL_DIRTY_AREA_NUM_MAX - 1], area);
+    if (a->y2 > b->y2) {
+        out[num++] = (sgl_area_t){ .x1 = a->x1, .y1 = b->y2 + 1, .x2 = a->x2, .y2 = a->y2 };
     }
+
+    return num;
 }
 
 
 /**
- * @brief initialize object
- * @param obj object
- * @param parent parent object
- * @return int, 0 means successful, -1 means failed
+ * @brief remove a dirty area from the dirty area pool
+ * @param index [in] index of the dirty area
+ * @return none
+ * @note the order of dirty areas is not kept
  */
-int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
+static inline void sgl_dirty_area_remove(int index)
 {
-    SGL_ASSERT(obj != NULL);
+    sgl_system.fbdev.dirty[index] = sgl_system.fbdev.dirty[--sgl_system.fbdev.dirty_num];
+}
 
-    if (parent == NULL) {
-        parent = sgl_screen_act();
-        if (parent == NULL) {
-            SGL_LOG_ERROR("sgl_obj_init: have no active page");
-            return -1;
+
+/**
+ * @brief check if an area overlaps the dirty areas except one
+ * @param area [in] Pointer to the area
+ * @param skip [in] index of the dirty area that is skipped
+ * @return true if the area does not overlap other dirty areas
+ */
+static inline bool sgl_dirty_area_is_alone(sgl_area_t *area, int skip)
+{
+    for (int i = 0; i < sgl_system.fbdev.dirty_num; i++) {
+        if (i != skip && sgl_area_is_overlap(&sgl_system.fbdev.dirty[i], area)) {
+            return false;
         }
     }
 
-    /* set essential member */
-    obj->coords = parent->coords;
-    obj->parent = parent;
-    obj->event_fn = NULL;
-    obj->event_data = 0;
-    obj->construct_fn = NULL;
-    obj->dirty = 1;
-    obj->clickable = 0;
-
-    /* init object area to invalid */
-    sgl_area_init(&obj->area);
-
-    /* add the child into parent's child list */
-    sgl_obj_add_child(parent, obj);
-
-    return 0;
+    return true;
 }
 
 
 /**
- * @brief  free an object
- * @param  obj: object to free
- * @retval none
- * @note this function will free all the itself and children of the object
+ * @brief union an area into dirty area region
+ *
+ * The region is a set of non-overlapping rectangles, the area is merged into the rectangle that
+ * costs least if the wasted pixels are less than the cost of one more rectangle, otherwise the
+ * covered part is subtracted and the rest pieces are added as new rectangles. When the pool is
+ * full, the area is merged into the rectangle that wastes least pixels.
+ *
+ * @param area [in] Pointer to the area
+ * @return none
+ */
+static void sgl_dirty_area_union(sgl_area_t *area)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    sgl_area_t rect = *area, merge, piece[4];
+    int i, best_idx, num;
+    uint32_t cost, min_cost;
+    bool full;
+
+    while (1) {
+        best_idx = -1;
+        min_cost = UINT32_MAX;
+        full = (fbdev->dirty_num >= SGL_DIRTY_AREA_NUM_MAX);
+
+        for (i = 0; i < fbdev->dirty_num; i++) {
+            if (sgl_area_is_contain(&fbdev->dirty[i], &rect)) {
+                /* already contains the area */
+                return;
+            }
+
+            cost = sgl_area_merge_cost(&fbdev->dirty[i], &rect);
+            if (cost >= min_cost || (!full && cost > CONFIG_SGL_DIRTY_AREA_RECT_COST)) {
+                continue;
+            }
+
+            /* the merged area must not overlap others, otherwise the subtracted pieces are merged again */
+            sgl_area_merge(&fbdev->dirty[i], &rect, &merge);
+            if (full || sgl_dirty_area_is_alone(&merge, i)) {
+                min_cost = cost;
+                best_idx = i;
+            }
+        }
+
+        /* merging is cheaper than one more rectangle, or there is no free slot */
+        if (best_idx >= 0) {
+            /* the bounding box may cover other rectangles when the pool is full, so union it again */
+            sgl_area_selfmerge(&rect, &fbdev->dirty[best_idx]);
+            sgl_dirty_area_remove(best_idx);
+            continue;
+        }
+
+        for (i = 0; i < fbdev->dirty_num; i++) {
+            if (sgl_area_is_overlap(&fbdev->dirty[i], &rect)) {
+                break;
+            }
+        }
+
+        if (i == fbdev->dirty_num) {
+            fbdev->dirty[fbdev->dirty_num++] = rect;
+            return;
+        }
+
+        /* not enough slots for the pieces, merge them instead */
+        if (fbdev->dirty_num + 4 > SGL_DIRTY_AREA_NUM_MAX) {
+            sgl_area_selfmerge(&rect, &fbdev->dirty[i]);
+            sgl_dirty_area_remove(i);
+            continue;
+        }
+
+        /* the pieces do not overlap dirty[i], union them with the others */
+        num = sgl_area_subtract(&rect, &fbdev->dirty[i], piece);
+        for (i = 0; i < num; i++) {
+            sgl_dirty_area_union(&piece[i]);
+        }
+        return;
+    }
+}
+
+
+/**
+ * @brief merge an area into global dirty area
+ * 
+ * The dirty area is a region of non-overlapping rectangles, so every damaged pixel is drawn only
+ * once. If the damaged pixels are more than CONFIG_SGL_DIRTY_AREA_THRESHOLD percent of screen,
+ * the region falls back to full screen.
+ * 
+ * @param area [in] Pointer to the area
+ * @return none
+ */
+void sgl_dirty_area_push(sgl_area_t *area)
+{
+    SGL_ASSERT(area != NULL);
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    sgl_area_t screen = { .x1 = 0, .y1 = 0, .x2 = SGL_SCREEN_WIDTH - 1, .y2 = SGL_SCREEN_HEIGHT - 1 };
+    sgl_area_t clip;
+    uint32_t pixels = 0;
+
+    /* skip invalid area */
+    if (area->x1 > area->x2 || area->y1 > area->y2 || !sgl_area_clip(area, &screen, &clip)) {
+        return;
+    }
+
+    /* count the pixels that are not damaged yet */
+    fbdev->dirty_stat.damaged += sgl_area_pixels(&clip);
+    for (int i = 0; i < fbdev->dirty_num; i++) {
+        fbdev->dirty_stat.damaged -= sgl_area_overlap_pixels(&fbdev->dirty[i], &clip);
+    }
+
+    sgl_dirty_area_union(&clip);
+
+#if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
+    for (int i = 0; i < fbdev->dirty_num; i++) {
+        pixels += sgl_area_pixels(&fbdev->dirty[i]);
+    }
+
+    if (fbdev->dirty_num > 1 && pixels * 100ULL >= sgl_area_pixels(&screen) * (uint64_t)CONFIG_SGL_DIRTY_AREA_THRESHOLD) {
+        fbdev->dirty[0] = screen;
+        fbdev->dirty_num = 1;
+        fbdev->dirty_stat.fallback ++;
+    }
+#else
+    SGL_UNUSED(pixels);
+#endif
+}
+
+
+/**
+ * @brief initialize object
+ * @param obj object
+ * @param parent parent object
+ * @return int, 0 means successful, -1 means failed
+ */
+int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
+{
+    SGL_ASSERT(obj != NULL);
+
+    if (parent == NULL) {
+        parent = sgl_screen_act();
+        if (parent == NULL) {
+            SGL_LOG_ERROR("sgl_obj_init: have no active page");
+            return -1;
+        }
+    }
+
+    /* set essential member */
+    obj->coords = parent->coords;
+    obj->parent = parent;
+#if (CONFIG_SGL_OBJ_COMPACT)
+    obj->ext = NULL;
+#else
+    obj->event_fn = NULL;
+    obj->event_data = 0;
+#endif
+    obj->construct_fn = NULL;
+    obj->dirty = 1;
+    obj->clickable = 0;
+
+    /* init object area to invalid */
+    sgl_area_init(&obj->area);
+
+    /* add the child into parent's child list */
+    sgl_obj_add_child(parent, obj);
+    sgl_obj_set_child_dirty(obj);
+
+    return 0;
+}
+
+
+/**
+ * @brief  release the resource of one object, the children and sibling are not touched
+ * @param  obj: object to release
+ * @retval none
+ */
+static void sgl_obj_release(sgl_obj_t *obj)
+{
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+    sgl_translate_drop(obj);
+#endif
+#if (CONFIG_SGL_OBJ_COMPACT)
+    if (obj->ext != NULL) {
+        sgl_free_tagged(obj->ext, SGL_MM_TAG_OBJECT);
+    }
+#endif
+    sgl_slab_free(obj);
+}
+
+
+/**
+ * @brief  free an object
+ * @param  obj: object to free
+ * @retval none
+ * @note this function will free all the itself and children of the object
  */
 void sgl_obj_free(sgl_obj_t *obj)
 {
@@ -944,11 +1622,79 @@ void sgl_obj_free(sgl_obj_t *obj)
 			stack[top++] = obj->child;
 		}
 
-        sgl_free(obj);
+        sgl_obj_release(obj);
     }
+
+    /* the hit index must not keep the freed objects */
+    sgl_obj_hit_invalidate();
 }
 
 
+#if (CONFIG_SGL_OBJ_FREE_BUDGET)
+/* the subtrees that are removed from the object tree and wait to be freed, linked by sibling */
+static sgl_obj_t *sgl_obj_reclaim_list = NULL;
+
+
+/**
+ * @brief  put the removed objects into reclaim list, they are freed a few per frame
+ * @param  obj: object to free, its siblings are freed too
+ * @retval none
+ * @note the objects must be removed from the object tree already
+ */
+static void sgl_obj_free_defer(sgl_obj_t *obj)
+{
+    sgl_obj_t *tail = obj;
+
+    SGL_ASSERT(obj != NULL);
+
+    while (tail->sibling != NULL) {
+        tail = tail->sibling;
+    }
+
+    tail->sibling = sgl_obj_reclaim_list;
+    sgl_obj_reclaim_list = obj;
+
+    /* the hit index must not keep the removed objects */
+    sgl_obj_hit_invalidate();
+}
+
+
+/**
+ * @brief  free the objects that are deleted, at most budget objects are freed
+ * @param  budget: max number of objects to free, 0 means free all of them
+ * @retval true if all deleted objects are freed, otherwise false
+ * @note it is called after every frame with CONFIG_SGL_OBJ_FREE_BUDGET, the application can call it
+ *       with 0 in idle time or before a large allocation to give back all the memory at once
+ */
+bool sgl_obj_reclaim(uint32_t budget)
+{
+    sgl_obj_t *obj = NULL, *child = NULL;
+    uint32_t count = 0;
+
+    while (sgl_obj_reclaim_list != NULL && (budget == 0 || count < budget)) {
+        obj = sgl_obj_reclaim_list;
+
+        /* move the children to the head of list, so the depth of tree does not matter */
+        if (obj->child != NULL) {
+            child = obj->child;
+            obj->child = child->sibling;
+            child->sibling = obj;
+            sgl_obj_reclaim_list = child;
+            continue;
+        }
+
+        sgl_obj_reclaim_list = obj->sibling;
+        sgl_obj_release(obj);
+        count ++;
+    }
+
+    return sgl_obj_reclaim_list == NULL;
+}
+#else
+#define sgl_obj_free_defer(obj)             sgl_obj_free(obj)
+#endif
+
+
 /**
  * @brief delete object
  * @param obj point to object
@@ -962,14 +1708,14 @@ void sgl_obj_delete(sgl_obj_t *obj)
     if (obj == NULL || obj == sgl_screen_act()) {
         obj = sgl_screen_act();
         if (obj->child) {
-            sgl_obj_free(obj->child);
+            sgl_obj_free_defer(obj->child);
         }
         sgl_obj_node_init(obj);
         sgl_obj_set_dirty(obj);
         return;
     }
     else if (obj->page == 1) {
-        sgl_obj_free(obj);
+        sgl_obj_free_defer(obj);
         return;
     }
 
@@ -1266,6 +2012,7 @@ sgl_pos_t sgl_get_icon_pos(sgl_area_t *area, const sgl_icon_pixmap_t *icon, int1
 void sgl_obj_set_pos_align(sgl_obj_t *obj, sgl_align_type_t type)
 {
     SGL_ASSERT(obj != NULL);
+    sgl_obj_coords_sync(obj);
 
     sgl_size_t p_size   = {0};
     sgl_pos_t  p_pos    = {0};
@@ -1307,6 +2054,8 @@ void sgl_obj_set_pos_align(sgl_obj_t *obj, sgl_align_type_t type)
 void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t type)
 {
     SGL_ASSERT(ref != NULL && obj != NULL);
+    sgl_obj_coords_sync(ref);
+    sgl_obj_coords_sync(obj);
 
     if (unlikely(ref == obj->parent)) {
         sgl_obj_set_pos_align(obj, type);
@@ -1318,6 +2067,8 @@ void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t
     int16_t ref_h = ref->coords.y2 - ref->coords.y1 + 1;
     int16_t obj_h = obj->coords.y2 - obj->coords.y1 + 1;
 
+    sgl_obj_hit_invalidate();
+
     switch (type) {
     case SGL_ALIGN_VERT_MID:
         obj->coords.x1 = ref->coords.x1 + (ref_w - obj_w) / 2;
@@ -1400,6 +2151,133 @@ static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
 }
 
 
+#if (SGL_BLIT_ENABLE)
+/**
+ * the copies of translated objects in framebuffer, they are prepared in dirty calculation,
+ * and checked with the display list before drawing
+ */
+static struct sgl_blit {
+    sgl_obj_t  *obj[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    sgl_area_t src[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    /* the part of this area that is not covered by the copy is exposed */
+    sgl_area_t fill[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    int16_t    ofs_x[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    int16_t    ofs_y[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    uint8_t    num;
+} sgl_blit;
+
+
+/**
+ * @brief prepare the copy of translated object, the exposed part is marked dirty when it is copied
+ * @param obj point to object that is not dirty in this frame
+ * @return none
+ * @note the moved object must be visible completely before and after moving, and the scrolled
+ *       object must not change its area, otherwise the object is drawn again
+ */
+static inline void sgl_blit_prepare(sgl_obj_t *obj)
+{
+    int index = sgl_translate_find(obj);
+    int16_t ofs_x, ofs_y;
+    sgl_area_t src, dst, fill;
+    bool copy = false;
+
+    if (index < 0 || sgl_trans.mode[index] == SGL_TRANSLATE_REDRAW) {
+        return;
+    }
+
+    ofs_x = sgl_trans.blit_x[index];
+    ofs_y = sgl_trans.blit_y[index];
+    copy = !obj->child_dirty && (ofs_x || ofs_y) && sgl_blit.num < CONFIG_SGL_TRANSLATE_NUM_MAX;
+
+    if (sgl_trans.mode[index] == SGL_TRANSLATE_MOVE) {
+        /* the object is not dirty, so its area is updated here */
+        fill = sgl_obj_get_fill_rect(obj->parent);
+        if (!sgl_area_clip(&fill, &obj->coords, &obj->area)) {
+            sgl_area_init(&obj->area);
+        }
+
+        src = sgl_trans.area[index];
+        dst = obj->area;
+        copy = copy && sgl_area_is_equal(&dst, &obj->coords)
+                    && src.x1 + ofs_x == dst.x1 && src.y1 + ofs_y == dst.y1
+                    && src.x2 + ofs_x == dst.x2 && src.y2 + ofs_y == dst.y2;
+
+        if (!copy) {
+            sgl_dirty_area_push(&src);
+            sgl_dirty_area_push(&obj->area);
+            return;
+        }
+
+        /* the exposed part is the old area that is not covered by the new area */
+        fill = src;
+    }
+    else {
+        fill = sgl_obj_get_fill_rect(obj);
+        copy = copy && sgl_area_is_equal(&sgl_trans.area[index], &obj->area)
+                    && sgl_area_clip(&sgl_trans.view[index], &fill, &src);
+
+        /* the pixels that are still in view after scrolling are copied */
+        dst = src;
+        dst.x1 += ofs_x;
+        dst.x2 += ofs_x;
+        dst.y1 += ofs_y;
+        dst.y2 += ofs_y;
+        copy = copy && sgl_area_selfclip(&dst, &src);
+
+        if (!copy) {
+            sgl_dirty_area_push(&obj->area);
+            return;
+        }
+
+        src = dst;
+        src.x1 -= ofs_x;
+        src.x2 -= ofs_x;
+        src.y1 -= ofs_y;
+        src.y2 -= ofs_y;
+    }
+
+    sgl_blit.obj[sgl_blit.num] = obj;
+    sgl_blit.src[sgl_blit.num] = src;
+    sgl_blit.fill[sgl_blit.num] = fill;
+    sgl_blit.ofs_x[sgl_blit.num] = ofs_x;
+    sgl_blit.ofs_y[sgl_blit.num] = ofs_y;
+    sgl_blit.num ++;
+}
+
+
+/**
+ * @brief copy area in framebuffer
+ * @param fbdev point to framebuffer device
+ * @param dst destination area
+ * @param src source area, it has the same size as destination area
+ * @return none
+ */
+static inline void sgl_fbdev_copy_area(sgl_fbdev_t *fbdev, sgl_area_t *dst, sgl_area_t *src)
+{
+    sgl_surf_t *surf = &fbdev->surf;
+    size_t size = (src->x2 - src->x1 + 1) * sizeof(sgl_color_t);
+    int16_t h = src->y2 - src->y1 + 1;
+
+    if (fbdev->fbinfo.copy_area != NULL) {
+        fbdev->fbinfo.copy_area(dst, src);
+        return;
+    }
+
+    /* the areas may overlap, copy the rows from the side that is not overwritten */
+    if (dst->y1 > src->y1) {
+        for (int16_t y = h - 1; y >= 0; y--) {
+            memmove(sgl_surf_get_buf(surf, dst->x1, dst->y1 + y), sgl_surf_get_buf(surf, src->x1, src->y1 + y), size);
+        }
+    }
+    else {
+        for (int16_t y = 0; y < h; y++) {
+            memmove(sgl_surf_get_buf(surf, dst->x1, dst->y1 + y), sgl_surf_get_buf(surf, src->x1, src->y1 + y), size);
+        }
+    }
+}
+#endif // !SGL_BLIT_ENABLE
+
+
 /**
  * @brief calculate dirty area by for each all object that is dirty and visible
  * @param obj it should point to active root object
@@ -1435,8 +2313,8 @@ static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
             /* remove obj from parent */
             sgl_obj_remove(obj);
 
-            /* free obj resource */
-            sgl_obj_free(obj);
+            /* free obj resource, it may be deferred to bound the time of frame */
+            sgl_obj_free_defer(obj);
 
             /* object is destroyed, skip */
             continue;
@@ -1448,12 +2326,22 @@ static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
                 .type = SGL_EVENT_DRAW_INIT,
             };
 
+            /* the flag is cleared first, so that the init can request another init for next frame */
+            sgl_obj_clear_needinit(obj);
+
             /* check construct function */
             SGL_ASSERT(obj->construct_fn != NULL);
             obj->construct_fn(NULL, obj, &evt);
-            /* maybe no need to clear flag */
-            sgl_obj_clear_needinit(obj);
+            /* the coords may be changed by init */
+            sgl_obj_hit_invalidate();
+        }
+
+#if (SGL_BLIT_ENABLE)
+        /* the translation of object that is not dirty can be copied in framebuffer */
+        if (sgl_trans.num > 0 && !sgl_obj_is_dirty(obj)) {
+            sgl_blit_prepare(obj);
         }
+#endif
 
         /* check child dirty and merge all dirty area */
         if (sgl_obj_is_dirty(obj)) {
@@ -1465,6 +2353,9 @@ static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
             if (unlikely(!sgl_area_clip(&fill_area, &obj->coords, &obj->area))) {
                 sgl_area_init(&obj->area);
                 sgl_obj_clear_dirty(obj);
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+                sgl_translate_apply(obj);
+#endif
                 continue;
             }
 
@@ -1475,10 +2366,535 @@ static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
             sgl_obj_clear_dirty(obj);
         }
 
-		if (obj->child != NULL) {
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+        /* move the children of translated object, they are inside the dirty area of object */
+        if (sgl_trans.num > 0) {
+            sgl_translate_apply(obj);
+        }
+#endif
+
+        /* skip the subtree that has nothing to do, the flag is kept when the subtree is not walked */
+		if (obj->child != NULL && obj->child_dirty) {
+            obj->child_dirty = 0;
 			stack[top++] = obj->child;
 		}
     }
+
+#if (CONFIG_SGL_TRANSLATE_NUM_MAX)
+    if (sgl_trans.num > 0) {
+        sgl_translate_flush();
+    }
+#endif
+}
+
+
+#if (CONFIG_SGL_DISPLAY_LIST_MAX)
+/**
+ * @brief display list entry
+ * @obj: visible object of current frame
+ * @next: index of the first entry after the subtree of obj
+ */
+typedef struct sgl_dlist_entry {
+    sgl_obj_t  *obj;
+    uint16_t   next;
+} sgl_dlist_entry_t;
+
+
+/**
+ * the display list of current frame, all visible objects are stored in draw order,
+ * and the objects that overlap current dirty area are binned into the bin array
+ */
+static struct sgl_dlist {
+    sgl_dlist_entry_t  entry[CONFIG_SGL_DISPLAY_LIST_MAX];
+    sgl_obj_t          *bin[CONFIG_SGL_DISPLAY_LIST_MAX];
+#if (CONFIG_SGL_OCCLUSION_CULLING)
+    uint8_t            culled[CONFIG_SGL_DISPLAY_LIST_MAX];
+#endif
+    uint16_t           count;
+    uint16_t           bin_num;
+} sgl_dlist;
+
+
+/**
+ * @brief flatten the object tree into the display list in draw order
+ * @param obj it should point to active root object
+ * @return true if success, false if the display list is too small
+ * @note the hidden objects and the objects that have no visible area are skipped with its children,
+ *       this is the same as draw_obj_slice, so the result of drawing is not changed
+ */
+static inline bool sgl_display_list_build(sgl_obj_t *obj)
+{
+    uint16_t open[SGL_OBJ_DEPTH_MAX];
+    int depth = 0;
+
+    sgl_dlist.count = 0;
+
+    while (obj != NULL) {
+        if (!sgl_obj_is_hidden(obj) && obj->area.x1 <= obj->area.x2) {
+            if (unlikely(sgl_dlist.count >= CONFIG_SGL_DISPLAY_LIST_MAX)) {
+                SGL_LOG_TRACE("sgl_display_list_build: display list is full, fallback to tree walk");
+                return false;
+            }
+
+            sgl_dlist.entry[sgl_dlist.count].obj = obj;
+            sgl_dlist.entry[sgl_dlist.count].next = sgl_dlist.count + 1;
+            sgl_dlist.count ++;
+
+            if (obj->child != NULL) {
+                SGL_ASSERT(depth < SGL_OBJ_DEPTH_MAX);
+                open[depth++] = sgl_dlist.count - 1;
+                obj = obj->child;
+                continue;
+            }
+        }
+
+        /* go to next sibling, and close all subtrees that are finished */
+        while (obj->sibling == NULL) {
+            if (depth == 0) {
+                return true;
+            }
+
+            sgl_dlist.entry[open[--depth]].next = sgl_dlist.count;
+            obj = obj->parent;
+        }
+        obj = obj->sibling;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief collect the objects that overlap the dirty area into the bin
+ * @param dirty dirty area
+ * @return none
+ * @note if an object does not overlap the dirty area, its subtree is skipped
+ */
+static inline void sgl_display_list_bin(sgl_area_t *dirty)
+{
+    uint16_t i = 0;
+
+    sgl_dlist.bin_num = 0;
+
+    while (i < sgl_dlist.count) {
+        if (sgl_area_is_overlap(dirty, &sgl_dlist.entry[i].obj->area)) {
+            sgl_dlist.bin[sgl_dlist.bin_num++] = sgl_dlist.entry[i].obj;
+            i++;
+        }
+        else {
+            i = sgl_dlist.entry[i].next;
+        }
+    }
+}
+
+
+#if (CONFIG_SGL_OCCLUSION_CULLING)
+/* the max number of opaque areas that are used to cull objects in one slice */
+#define  SGL_OCCLUDER_NUM_MAX              (8)
+
+
+/**
+ * @brief mark the binned objects that are covered by opaque objects above them
+ * @param surf surface that draw to
+ * @return none
+ * @note the bin is walked from front to back, an object is culled when its visible part in the
+ *       slice is completely inside the area of one opaque object that is drawn after it
+ */
+static inline void sgl_display_list_cull(sgl_surf_t *surf)
+{
+    sgl_area_t occluder[SGL_OCCLUDER_NUM_MAX];
+    sgl_area_t clip;
+    sgl_obj_t *obj = NULL;
+    int occluder_num = 0, j = 0;
+
+    for (int i = sgl_dlist.bin_num - 1; i >= 0; i--) {
+        obj = sgl_dlist.bin[i];
+        sgl_dlist.culled[i] = 0;
+
+        if (!sgl_surf_clip(surf, &obj->area, &clip)) {
+            continue;
+        }
+
+        for (j = 0; j < occluder_num; j++) {
+            if (sgl_area_is_contain(&occluder[j], &clip)) {
+                sgl_dlist.culled[i] = 1;
+                break;
+            }
+        }
+
+        if (sgl_dlist.culled[i]) {
+            continue;
+        }
+
+        if (sgl_obj_is_opaque(obj) && occluder_num < SGL_OCCLUDER_NUM_MAX) {
+            occluder[occluder_num++] = clip;
+        }
+    }
+}
+#endif // !CONFIG_SGL_OCCLUSION_CULLING
+
+
+/**
+ * @brief draw the binned objects that overlap the slice into surface
+ * @param surf surface that draw to, it is the slice or a band of the slice
+ * @param slice the slice that the surface belongs to
+ * @return none
+ * @note the objects that are covered by opaque objects are skipped, and the objects are
+ *       selected by slice, so a band draws the same objects as the whole slice
+ */
+static inline void draw_bin_band(sgl_surf_t *surf, sgl_surf_t *slice)
+{
+    sgl_event_t evt;
+    sgl_obj_t *obj = NULL;
+
+    for (uint16_t i = 0; i < sgl_dlist.bin_num; i++) {
+        obj = sgl_dlist.bin[i];
+
+#if (CONFIG_SGL_OCCLUSION_CULLING)
+        if (sgl_dlist.culled[i]) {
+            continue;
+        }
+#endif
+
+        if (sgl_surf_area_is_overlap(slice, &obj->area)) {
+            evt.type = SGL_EVENT_DRAW_MAIN;
+            SGL_ASSERT(obj->construct_fn != NULL);
+            obj->construct_fn(surf, obj, &evt);
+        }
+    }
+}
+
+
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+/**
+ * the render worker pool, a slice is split into horizontal bands, the band 0 is drawn by
+ * the caller and the other bands are drawn by the workers at the same time
+ */
+static struct sgl_render_pool {
+    pthread_t          thread[CONFIG_SGL_RENDER_THREADS - 1];
+    pthread_mutex_t    lock;
+    pthread_cond_t     start;
+    pthread_cond_t     done;
+    sgl_surf_t         band[CONFIG_SGL_RENDER_THREADS];
+    sgl_surf_t         *slice;
+    uint32_t           seq;
+    uint8_t            band_num;
+    uint8_t            thread_num;
+    uint8_t            pending;
+} sgl_render_pool;
+
+
+/**
+ * @brief render worker thread, it draws its own band when a slice is started
+ * @param arg band index of worker
+ * @return none
+ */
+static void* sgl_render_worker(void *arg)
+{
+    uint8_t id = (uint8_t)(uintptr_t)arg;
+    uint32_t seq = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&sgl_render_pool.lock);
+        while (sgl_render_pool.seq == seq) {
+            pthread_cond_wait(&sgl_render_pool.start, &sgl_render_pool.lock);
+        }
+        seq = sgl_render_pool.seq;
+        pthread_mutex_unlock(&sgl_render_pool.lock);
+
+        if (id < sgl_render_pool.band_num) {
+            draw_bin_band(&sgl_render_pool.band[id], sgl_render_pool.slice);
+        }
+
+        pthread_mutex_lock(&sgl_render_pool.lock);
+        if (--sgl_render_pool.pending == 0) {
+            pthread_cond_signal(&sgl_render_pool.done);
+        }
+        pthread_mutex_unlock(&sgl_render_pool.lock);
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief start the render workers
+ * @param none
+ * @return int, 0 means success, -1 means no worker is started, the slices are drawn by caller only
+ */
+static int sgl_render_pool_init(void)
+{
+    uint8_t i = 0;
+
+    if (sgl_render_pool.thread_num) {
+        return 0;
+    }
+
+    pthread_mutex_init(&sgl_render_pool.lock, NULL);
+    pthread_cond_init(&sgl_render_pool.start, NULL);
+    pthread_cond_init(&sgl_render_pool.done, NULL);
+
+    for (i = 0; i < CONFIG_SGL_RENDER_THREADS - 1; i++) {
+        if (pthread_create(&sgl_render_pool.thread[i], NULL, sgl_render_worker, (void*)(uintptr_t)(i + 1))) {
+            SGL_LOG_WARN("sgl_render_pool_init: only %d render workers are started", i);
+            break;
+        }
+    }
+    sgl_render_pool.thread_num = i;
+
+    return i ? 0 : -1;
+}
+
+
+/**
+ * @brief split the surface into bands and draw the bands in parallel
+ * @param surf surface that draw to
+ * @return none
+ * @note this function returns after all bands are finished
+ */
+static inline void draw_bin_bands(sgl_surf_t *surf)
+{
+    int16_t y1 = sgl_max(surf->y1, surf->dirty->y1);
+    int16_t y2 = sgl_min(surf->y2, surf->dirty->y2);
+    int16_t band_h = 0, h = y2 - y1 + 1;
+    uint8_t band_num = sgl_min(sgl_render_pool.thread_num + 1, h);
+    sgl_surf_t *band = NULL;
+
+    if (band_num <= 1) {
+        draw_bin_band(surf, surf);
+        return;
+    }
+
+    band_h = (h + band_num - 1) / band_num;
+    band_num = (h + band_h - 1) / band_h;
+
+    for (uint8_t i = 0; i < band_num; i++) {
+        band = &sgl_render_pool.band[i];
+        *band = *surf;
+        band->y1 = y1 + i * band_h;
+        band->y2 = sgl_min(band->y1 + band_h - 1, y2);
+        band->h = band->y2 - band->y1 + 1;
+        band->size = band->h * surf->w;
+        band->buffer = sgl_surf_get_buf(surf, 0, band->y1 - surf->y1);
+        band->band = i;
+    }
+
+    pthread_mutex_lock(&sgl_render_pool.lock);
+    sgl_render_pool.band_num = band_num;
+    sgl_render_pool.slice = surf;
+    sgl_render_pool.pending = sgl_render_pool.thread_num;
+    sgl_render_pool.seq ++;
+    pthread_cond_broadcast(&sgl_render_pool.start);
+    pthread_mutex_unlock(&sgl_render_pool.lock);
+
+    draw_bin_band(&sgl_render_pool.band[0], surf);
+
+    pthread_mutex_lock(&sgl_render_pool.lock);
+    while (sgl_render_pool.pending) {
+        pthread_cond_wait(&sgl_render_pool.done, &sgl_render_pool.lock);
+    }
+    pthread_mutex_unlock(&sgl_render_pool.lock);
+}
+#endif // !CONFIG_SGL_RENDER_THREADS
+
+
+/**
+ * @brief draw the binned objects into surface slice
+ * @param surf surface that draw to
+ * @return none
+ * @note the slices of a dirty area are drawn from top to bottom, so the objects that are
+ *       above current slice will never be drawn again, they are removed from the bin
+ */
+static inline void draw_bin_slice(sgl_surf_t *surf)
+{
+    sgl_obj_t *obj = NULL;
+    uint16_t keep = 0;
+
+    for (uint16_t i = 0; i < sgl_dlist.bin_num; i++) {
+        obj = sgl_dlist.bin[i];
+
+        if (obj->area.y2 >= surf->y1) {
+            sgl_dlist.bin[keep++] = obj;
+        }
+    }
+    sgl_dlist.bin_num = keep;
+
+#if (CONFIG_SGL_OCCLUSION_CULLING)
+    sgl_display_list_cull(surf);
+#endif
+
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+    draw_bin_bands(surf);
+#else
+    draw_bin_band(surf, surf);
+#endif
+}
+#endif // !CONFIG_SGL_DISPLAY_LIST_MAX
+
+
+#if (SGL_BLIT_ENABLE)
+/**
+ * @brief copy the prepared areas of translated objects in framebuffer
+ * @param fbdev point to framebuffer device
+ * @param use_dlist true if the display list of current frame is built
+ * @return none
+ * @note a copy is dropped and both areas are drawn again if any object above the translated object
+ *       overlaps them, the copies are done from front to back, so a copy never reads the pixels
+ *       that are written by another copy, and the dirty areas in source are moved with the copy
+ */
+static inline void sgl_blit_task(sgl_fbdev_t *fbdev, bool use_dlist)
+{
+    int order[CONFIG_SGL_TRANSLATE_NUM_MAX];
+    sgl_area_t moved[SGL_DIRTY_AREA_NUM_MAX + 4];
+    sgl_area_t dst;
+    int i, j, k, num;
+
+    for (i = 0; i < sgl_blit.num; i++) {
+        order[i] = -1;
+        dst = sgl_blit.src[i];
+        dst.x1 += sgl_blit.ofs_x[i];
+        dst.x2 += sgl_blit.ofs_x[i];
+        dst.y1 += sgl_blit.ofs_y[i];
+        dst.y2 += sgl_blit.ofs_y[i];
+
+        for (j = 0; use_dlist && j < sgl_dlist.count; j++) {
+            if (sgl_dlist.entry[j].obj != sgl_blit.obj[i]) {
+                continue;
+            }
+
+            /* the entries after the subtree of object are drawn above it */
+            for (k = sgl_dlist.entry[j].next; k < sgl_dlist.count; k++) {
+                if (sgl_area_is_overlap(&sgl_dlist.entry[k].obj->area, &sgl_blit.src[i])
+                    || sgl_area_is_overlap(&sgl_dlist.entry[k].obj->area, &dst)) {
+                    break;
+                }
+            }
+
+            if (k == sgl_dlist.count) {
+                order[i] = j;
+            }
+            break;
+        }
+
+        if (order[i] < 0) {
+            sgl_dirty_area_push(&sgl_blit.fill[i]);
+            sgl_dirty_area_push(&dst);
+        }
+    }
+
+    for (;;) {
+        for (i = 0, j = -1; i < sgl_blit.num; i++) {
+            if (order[i] >= 0 && (j < 0 || order[i] > order[j])) {
+                j = i;
+            }
+        }
+
+        if (j < 0) {
+            break;
+        }
+        order[j] = -1;
+
+        dst = sgl_blit.src[j];
+        dst.x1 += sgl_blit.ofs_x[j];
+        dst.x2 += sgl_blit.ofs_x[j];
+        dst.y1 += sgl_blit.ofs_y[j];
+        dst.y2 += sgl_blit.ofs_y[j];
+
+        /* the source pixels that are not valid are drawn again at the destination */
+        for (i = 0, num = 0; i < fbdev->dirty_num; i++) {
+            if (sgl_area_is_contain(&fbdev->dirty[i], &dst)) {
+                break;
+            }
+
+            if (sgl_area_clip(&fbdev->dirty[i], &sgl_blit.src[j], &moved[num])) {
+                moved[num].x1 += sgl_blit.ofs_x[j];
+                moved[num].x2 += sgl_blit.ofs_x[j];
+                moved[num].y1 += sgl_blit.ofs_y[j];
+                moved[num].y2 += sgl_blit.ofs_y[j];
+                num ++;
+            }
+        }
+
+        if (i == fbdev->dirty_num) {
+            sgl_fbdev_copy_area(fbdev, &dst, &sgl_blit.src[j]);
+        }
+        else {
+            num = 0;
+        }
+
+        /* the exposed pieces are not valid for the copies behind this object */
+        if (sgl_area_is_overlap(&sgl_blit.fill[j], &dst)) {
+            num += sgl_area_subtract(&sgl_blit.fill[j], &dst, &moved[num]);
+        }
+        else {
+            moved[num++] = sgl_blit.fill[j];
+        }
+
+        for (i = 0; i < num; i++) {
+            sgl_dirty_area_push(&moved[i]);
+        }
+    }
+
+    sgl_blit.num = 0;
+}
+#endif // !SGL_BLIT_ENABLE
+
+
+/**
+ * @brief the time budget of frame, the drawing is suspended when it is spent
+ * @clock_us: clock of host in microseconds
+ * @start: time of current frame start
+ * @budget: time budget of current frame, 0 means no budget
+ */
+static struct sgl_task_budget {
+    uint32_t  (*clock_us)(void);
+    uint32_t  start;
+    uint32_t  budget;
+} sgl_task_budget = {
+    .clock_us = NULL,
+    .start = 0,
+    .budget = 0,
+};
+
+
+/**
+ * @brief check whether the drawing should give the control back to caller
+ * @param none
+ * @return true if the budget of frame is spent or an event is waiting, otherwise false
+ */
+static inline bool sgl_task_should_yield(void)
+{
+    if (likely(sgl_task_budget.budget == 0)) {
+        return false;
+    }
+
+    return sgl_event_queue_is_pending()
+           || sgl_task_budget.clock_us() - sgl_task_budget.start >= sgl_task_budget.budget;
+}
+
+
+/**
+ * @brief keep the dirty areas that are not drawn, they are drawn in next frame
+ * @param fbdev point to frame buffer device
+ * @param index index of the first dirty area that is not finished
+ * @param y1 the first line of the dirty area that is not drawn
+ * @return none
+ */
+static void sgl_dirty_area_suspend(sgl_fbdev_t *fbdev, int index, int16_t y1)
+{
+    int num = 0;
+
+    if (y1 <= fbdev->dirty[index].y2) {
+        fbdev->dirty[num] = fbdev->dirty[index];
+        fbdev->dirty[num].y1 = y1;
+        num ++;
+    }
+
+    for (int i = index + 1; i < fbdev->dirty_num; i++) {
+        fbdev->dirty[num++] = fbdev->dirty[i];
+    }
+
+    fbdev->dirty_num = num;
 }
 
 
@@ -1486,7 +2902,8 @@ static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
  * @brief sgl to draw complete frame
  * @param fbdev point to  frame buffer device
  * @return none
- * @note this function should be called in deamon thread or cyclic thread
+ * @note this function should be called in deamon thread or cyclic thread. If the frame has a time
+ *       budget, the drawing stops after the slice that spends it, and the rest is kept dirty
  */
 static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
 {
@@ -1494,11 +2911,34 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
     sgl_obj_t  *head = fbdev->active;
     sgl_area_t *dirty = NULL;
 
+#if (CONFIG_SGL_DISPLAY_LIST_MAX)
+    bool use_dlist = false;
+
+    /* walk the object tree only once for all dirty areas and slices */
+#if (SGL_BLIT_ENABLE)
+    if (fbdev->dirty_num > 0 || sgl_blit.num > 0) {
+#else
+    if (fbdev->dirty_num > 0) {
+#endif
+        use_dlist = sgl_display_list_build(head);
+    }
+#endif
+
+#if (SGL_BLIT_ENABLE)
+    /* the exposed areas of copies are marked dirty after the copies are checked */
+    if (sgl_blit.num > 0) {
+        sgl_blit_task(fbdev, use_dlist);
+    }
+#endif
+
     /* dirty area number must less than SGL_DIRTY_AREA_MAX */
     for (int i = 0; i < fbdev->dirty_num; i++) {
         dirty = &fbdev->dirty[i];
         surf->dirty = dirty;
 
+        fbdev->dirty_stat.redrawn += sgl_area_pixels(dirty);
+        fbdev->dirty_stat.rects ++;
+
 #if (CONFIG_SGL_FBDEV_RUNTIME_ROTATION)
         sgl_area_t screen = { .x1 = 0, .y1 = 0, .x2 = SGL_SCREEN_WIDTH - 1, .y2 = SGL_SCREEN_HEIGHT - 1 };
         sgl_area_selfclip(dirty, &screen);
@@ -1507,6 +2947,12 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
         /* check dirty area, ensure it is valid */
         SGL_ASSERT(dirty != NULL && dirty->x1 >= 0 && dirty->y1 >= 0 && dirty->x2 < SGL_SCREEN_WIDTH && dirty->y2 < SGL_SCREEN_HEIGHT);
 
+#if (CONFIG_SGL_DISPLAY_LIST_MAX)
+        if (use_dlist) {
+            sgl_display_list_bin(dirty);
+        }
+#endif
+
 #if (!CONFIG_SGL_USE_FBDEV_VRAM)
 
         uint16_t draw_h = 0;
@@ -1518,28 +2964,65 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
         surf->w  = surf->x2 - surf->x1 + 1;
         surf->h  = sgl_min(surf->size / surf->w, (uint32_t)(dirty->y2 - dirty->y1 + 1));
 
-        SGL_LOG_TRACE("[fb:%d]sgl_draw_task: dirty area  x1:%d y1:%d x2:%d y2:%d", fbdev->fb_swap, dirty->x1, dirty->y1, dirty->x2, dirty->y2);
+        SGL_LOG_TRACE("[fb:%d]sgl_draw_task: dirty area  x1:%d y1:%d x2:%d y2:%d", fbdev->fb_index, dirty->x1, dirty->y1, dirty->x2, dirty->y2);
 
         while (surf->y1 <= dirty->y2) {
             draw_h = sgl_min(dirty->y2 - surf->y1 + 1, surf->h);
             surf->y2 = surf->y1 + draw_h - 1;
 
-            /* wait current framebuffer for ready */
-            while (sgl_fbdev_flush_wait_ready(fbdev));
-
-            /* reset current framebuffer ready flag */
-            fbdev->fb_status = (fbdev->fb_status & (2 - fbdev->fb_swap));
+            /* render ahead: wait until at least one draw buffer of the ring is free */
+            sgl_fbdev_flush_wait(fbdev, fbdev->fb_num - 1);
+            surf->buffer = (sgl_color_t*)fbdev->fbinfo.buffer[fbdev->fb_index];
 
             /* draw object slice until the dirty area is finished */
+#if (CONFIG_SGL_DISPLAY_LIST_MAX)
+            if (use_dlist) {
+                draw_bin_slice(surf);
+                sgl_fbdev_flush_area((sgl_area_t*)surf, surf->buffer);
+            }
+            else {
+                draw_obj_slice(head, surf);
+            }
+#else
             draw_obj_slice(head, surf);
+#endif
+            /* the flushing buffer is owned by the device, switch to next draw buffer */
+            fbdev->fb_index = (fbdev->fb_index + 1) % fbdev->fb_num;
             surf->y1 += draw_h;
+
+            if (unlikely(sgl_task_should_yield()) && (surf->y1 <= dirty->y2 || i + 1 < fbdev->dirty_num)) {
+                sgl_dirty_area_suspend(fbdev, i, surf->y1);
+                return;
+            }
         }
 #else
         /* check dirty area, ensure it is valid */
         SGL_ASSERT(dirty != NULL && dirty->x1 >= 0 && dirty->y1 >= 0 && dirty->x2 < SGL_SCREEN_WIDTH && dirty->y2 < SGL_SCREEN_HEIGHT);
 
-        SGL_LOG_TRACE("[fb:%d]sgl_draw_task: dirty area  x1:%d y1:%d x2:%d y2:%d", fbdev->fb_swap, dirty->x1, dirty->y1, dirty->x2, dirty->y2);
+        SGL_LOG_TRACE("[fb:%d]sgl_draw_task: dirty area  x1:%d y1:%d x2:%d y2:%d", fbdev->fb_index, dirty->x1, dirty->y1, dirty->x2, dirty->y2);
+#if (CONFIG_SGL_DISPLAY_LIST_MAX)
+        if (use_dlist) {
+            /* only the binned objects are drawn, so the drawing must be limited in the dirty area */
+            sgl_surf_t view = *surf;
+            view.x1 = dirty->x1;
+            view.y1 = dirty->y1;
+            view.x2 = dirty->x2;
+            view.y2 = dirty->y2;
+            view.h  = dirty->y2 - dirty->y1 + 1;
+            view.buffer = sgl_surf_get_buf(surf, dirty->x1 - surf->x1, dirty->y1 - surf->y1);
+            draw_bin_slice(&view);
+            sgl_fbdev_flush_area((sgl_area_t*)surf, surf->buffer);
+        }
+        else {
+            draw_obj_slice(head, surf);
+        }
+#else
         draw_obj_slice(head, surf);
+#endif
+        if (unlikely(sgl_task_should_yield()) && i + 1 < fbdev->dirty_num) {
+            sgl_dirty_area_suspend(fbdev, i + 1, fbdev->dirty[i + 1].y1);
+            return;
+        }
 #endif
     }
     /* clear dirty area */
@@ -1547,6 +3030,46 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
 }
 
 
+/**
+ * @brief get the time until sgl task has work to do
+ * @param none
+ * @return milliseconds until the next frame is needed, 0 if it is needed now,
+ *         SGL_TASK_DEADLINE_IDLE if nothing is animating, dirty or queued
+ */
+uint32_t sgl_task_next_deadline(void)
+{
+    sgl_obj_t *active = sgl_system.fbdev.active;
+    uint32_t tick = sgl_tick_get();
+    uint32_t frame = tick < SGL_SYSTEM_TICK_MS ? SGL_SYSTEM_TICK_MS - tick : 0;
+    uint32_t deadline = SGL_TASK_DEADLINE_IDLE;
+
+    /* the queued events and the changed objects are handled in next frame */
+    if (sgl_event_queue_is_pending() || sgl_system.fbdev.dirty_num > 0) {
+        return frame;
+    }
+
+    if (active != NULL && (active->dirty || active->child_dirty)) {
+        return frame;
+    }
+
+#if (CONFIG_SGL_OBJ_FREE_BUDGET)
+    if (sgl_obj_reclaim_list != NULL) {
+        return frame;
+    }
+#endif
+
+#if (CONFIG_SGL_ANIMATION)
+    /* the running animation steps every frame, the delayed one wakes up after its delay */
+    deadline = sgl_anim_next_deadline();
+    if (deadline != SGL_TASK_DEADLINE_IDLE) {
+        deadline = sgl_max(deadline, frame);
+    }
+#endif
+
+    return deadline;
+}
+
+
 /**
  * @brief sgl task handle function with sync mode
  * @param none
@@ -1568,4 +3091,48 @@ void sgl_task_handle_sync(void)
 
     /* draw all object into screen */
     sgl_draw_task(&sgl_system.fbdev);
+
+    /* the transient buffers of this frame are not used anymore */
+    sgl_scratch_reset();
+
+#if (CONFIG_SGL_OBJ_FREE_BUDGET)
+    /* free a few deleted objects, the damage of them is drawn already */
+    sgl_obj_reclaim(CONFIG_SGL_OBJ_FREE_BUDGET);
+#endif
+}
+
+
+/**
+ * @brief set the clock of host that is used by the time budget of frame
+ * @param clock_us function that returns the time in microseconds, it may wrap around
+ * @return none
+ */
+void sgl_task_set_clock(uint32_t (*clock_us)(void))
+{
+    sgl_task_budget.clock_us = clock_us;
+}
+
+
+/**
+ * @brief sgl task handle function with time budget
+ * @param budget_us time budget of frame in microseconds
+ * @return none
+ * @note the frame draws slices until the budget is spent or an event is queued, the rest of dirty
+ *       areas is drawn by next call after the events are handled, so a large repaint does not
+ *       block the input. At least one slice is drawn in every call
+ */
+void sgl_task_handle_budget(uint32_t budget_us)
+{
+    if (sgl_task_budget.clock_us == NULL) {
+        SGL_LOG_WARN("sgl_task_handle_budget: no clock, please call sgl_task_set_clock");
+        sgl_task_handle_sync();
+        return;
+    }
+
+    sgl_task_budget.start = sgl_task_budget.clock_us();
+    sgl_task_budget.budget = sgl_max(budget_us, 1u);
+
+    sgl_task_handle_sync();
+
+    sgl_task_budget.budget = 0;
 }
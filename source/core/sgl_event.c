@@ -34,17 +34,80 @@
 #define SGL_EVENT_QUEUE_SIZE          (CONFIG_SGL_EVENT_QUEUE_SIZE)
 #define SGL_EVENT_QUEUE_SIZE_MASK     (SGL_EVENT_QUEUE_SIZE - 1)
 
+/* the number of events that are taken from queue at once */
+#define SGL_EVENT_BATCH_SIZE          (8)
+
+
+/**
+ * The event queue is written by input context, such as timer handler or input thread, and read by
+ * sgl_event_task, so the indexes are published with release and read with acquire. The indexes
+ * are free running, the slot is the index masked by size, so all slots of queue are used.
+ */
+typedef sgl_atomic_uint_t             sgl_evtq_index_t;
+#define sgl_evtq_load(p, order)       sgl_atomic_load(p, order)
+#define sgl_evtq_store(p, v, order)   sgl_atomic_store(p, v, order)
+#define sgl_evtq_inc(p)               sgl_atomic_inc(p, relaxed)
+
+#if (SGL_ATOMIC_C11)
+#define sgl_evtq_xchg(p, v)           atomic_exchange_explicit(p, v, memory_order_relaxed)
+#define sgl_evtq_cas(p, old, v)       atomic_compare_exchange_weak_explicit(p, old, v, memory_order_relaxed, memory_order_relaxed)
+#define SGL_EVENT_MOTION_MERGE        (CONFIG_SGL_EVENT_MOTION_MERGE)
+#else
+#if (CONFIG_SGL_EVENT_QUEUE_MPSC)
+#error "CONFIG_SGL_EVENT_QUEUE_MPSC needs C11 atomics"
+#endif
+/* the motion can not be merged safely without compare and exchange */
+#define SGL_EVENT_MOTION_MERGE        (0)
+#endif
+
+
+#if (SGL_EVENT_MOTION_MERGE)
+/**
+ * The motion of input device is kept in the cell of its slot, x and y are packed into 31 bits.
+ * The input context moves the motion in the cell until the motion is taken by sgl_event_task or
+ * another input event is sent, so there is at most one queued motion between press and release.
+ */
+#define SGL_EVENT_MOTION_VALID        (0x80000000u)
+
+static inline unsigned int sgl_event_motion_pack(sgl_event_pos_t pos)
+{
+    return SGL_EVENT_MOTION_VALID | ((unsigned int)(pos.x & 0x7fff) << 16) | (uint16_t)pos.y;
+}
+
+static inline sgl_event_pos_t sgl_event_motion_unpack(unsigned int motion)
+{
+    sgl_event_pos_t pos = {
+        .x = (int16_t)((motion >> 15) & 0xfffe) >> 1,
+        .y = (int16_t)(motion & 0xffff),
+    };
+    return pos;
+}
+
+/* the motion event that is sent by input device */
+#define sgl_event_is_input_motion(e)  ((e)->obj == NULL && (e)->type == SGL_EVENT_MOTION)
+#endif
+
+
 /**
  * @brief event queue struct
  * @buffer: event buffer to save all event data
+ * @seq: sequence of every slot, the slot is ready to pop when it is equal to index + 1 (MPSC only)
+ * @motion: the latest position of input motion in every slot
  * @head: event queue head which is used to push event
  * @tail: event queue tail which is used to pop event
- * @count: event queue count which have been pushed
+ * @overflow: the number of events that are dropped because the queue is full
  */
 typedef struct event_queue {
-    sgl_event_t buffer[SGL_EVENT_QUEUE_SIZE];
-    uint16_t    head;
-    uint16_t    tail;
+    sgl_event_t       buffer[SGL_EVENT_QUEUE_SIZE];
+#if (CONFIG_SGL_EVENT_QUEUE_MPSC)
+    sgl_evtq_index_t  seq[SGL_EVENT_QUEUE_SIZE];
+#endif
+#if (SGL_EVENT_MOTION_MERGE)
+    sgl_evtq_index_t  motion[SGL_EVENT_QUEUE_SIZE];
+#endif
+    sgl_evtq_index_t  head;
+    sgl_evtq_index_t  tail;
+    sgl_evtq_index_t  overflow;
 } event_queue_t;
 
 
@@ -52,11 +115,19 @@ typedef struct event_queue {
  * @brief event context struct
  * @last_click: last click object which may be lost event
  * @last_touch: last touch position
+ * @last_overflow: the overflow count of queue that is reported
+ * @motion_slot: the slot of last input motion that can be merged, -1 if none, input context only
+ * @wake_cb: callback that is called in input context when an event is queued
  * @evtq: event queue
  */
 static struct event_context {
     struct sgl_obj *last_click;
     sgl_event_pos_t last_touch;
+    uint32_t        last_overflow;
+    sgl_event_wake_cb_t wake_cb;
+#if (SGL_EVENT_MOTION_MERGE)
+    int             motion_slot;
+#endif
     event_queue_t   evtq;
 } evt_ctx;
 
@@ -75,65 +146,232 @@ int sgl_event_queue_init(void)
         return -1;
     }
 
-    evt_ctx.evtq.head = evt_ctx.evtq.tail = 0;
+    for (unsigned int i = 0; i < SGL_EVENT_QUEUE_SIZE; i++) {
+#if (CONFIG_SGL_EVENT_QUEUE_MPSC)
+        sgl_evtq_store(&evt_ctx.evtq.seq[i], i, relaxed);
+#endif
+#if (SGL_EVENT_MOTION_MERGE)
+        sgl_evtq_store(&evt_ctx.evtq.motion[i], 0, relaxed);
+#endif
+    }
+
+#if (SGL_EVENT_MOTION_MERGE)
+    evt_ctx.motion_slot = -1;
+#endif
+
+    sgl_evtq_store(&evt_ctx.evtq.head, 0, relaxed);
+    sgl_evtq_store(&evt_ctx.evtq.tail, 0, relaxed);
+    sgl_evtq_store(&evt_ctx.evtq.overflow, 0, relaxed);
+    evt_ctx.last_overflow = 0;
     return 0;
 }
 
 
 /**
- * @brief Check whether the event queue is empty
- * @param none
- * @return true if the event queue is empty, false otherwise
+ * @brief Fill the slot of queue before it is published
+ * @param slot The slot of queue
+ * @param event The event to be pushed
+ * @return none
  */
-static inline bool sgl_event_queue_is_empty(void)
+static inline void sgl_event_queue_fill(unsigned int slot, const sgl_event_t *event)
 {
-    return evt_ctx.evtq.head == evt_ctx.evtq.tail;
+    evt_ctx.evtq.buffer[slot] = *event;
+
+#if (SGL_EVENT_MOTION_MERGE)
+    if (sgl_event_is_input_motion(event)) {
+        sgl_evtq_store(&evt_ctx.evtq.motion[slot], sgl_event_motion_pack(event->pos), relaxed);
+    }
+#endif
 }
 
 
 /**
- * @brief Check whether the event queue is full
- * @param none
- * @return true if the event queue is full, false otherwise
+ * @brief Take the event of slot before the slot is given back to producer
+ * @param slot The slot of queue
+ * @param out_event The event to be popped
+ * @return none
  */
-static inline bool sgl_event_queue_is_full(void)
+static inline void sgl_event_queue_take(unsigned int slot, sgl_event_t *out_event)
 {
-    uint32_t next_head = (evt_ctx.evtq.head + 1) & SGL_EVENT_QUEUE_SIZE_MASK;
-    return next_head == evt_ctx.evtq.tail;
+    *out_event = evt_ctx.evtq.buffer[slot];
+
+#if (SGL_EVENT_MOTION_MERGE)
+    /* the input context can not move the motion after it is taken */
+    if (sgl_event_is_input_motion(out_event)) {
+        out_event->pos = sgl_event_motion_unpack(sgl_evtq_xchg(&evt_ctx.evtq.motion[slot], 0));
+    }
+#endif
 }
 
 
+#if (CONFIG_SGL_EVENT_QUEUE_MPSC)
+/**
+ * @brief Put an event into the event queue
+ * @param event The event to be pushed
+ * @return The slot of event, -1 if the queue is full
+ * @note it can be called from many threads at the same time, the producers claim the slot by
+ *       moving head, and publish the event by the sequence of slot
+ */
+static int sgl_event_queue_put(const sgl_event_t *event)
+{
+    unsigned int pos = sgl_evtq_load(&evt_ctx.evtq.head, relaxed);
+    unsigned int seq;
+
+    for (;;) {
+        seq = sgl_evtq_load(&evt_ctx.evtq.seq[pos & SGL_EVENT_QUEUE_SIZE_MASK], acquire);
+
+        if (seq == pos) {
+            if (sgl_evtq_cas(&evt_ctx.evtq.head, &pos, pos + 1)) {
+                break;
+            }
+        }
+        else if ((int)(seq - pos) < 0) {
+            /* the slot is not popped yet, the queue is full */
+            return -1;
+        }
+        else {
+            pos = sgl_evtq_load(&evt_ctx.evtq.head, relaxed);
+        }
+    }
+
+    sgl_event_queue_fill(pos & SGL_EVENT_QUEUE_SIZE_MASK, event);
+    sgl_evtq_store(&evt_ctx.evtq.seq[pos & SGL_EVENT_QUEUE_SIZE_MASK], pos + 1, release);
+    return (int)(pos & SGL_EVENT_QUEUE_SIZE_MASK);
+}
+
+
+/**
+ * @brief Pop events from the event queue
+ * @param out_event The buffer of events to be popped
+ * @param max The max number of events to be popped
+ * @return The number of events that are popped, 0 if the queue is empty
+ */
+static int sgl_event_queue_pop_batch(sgl_event_t *out_event, int max)
+{
+    unsigned int pos = sgl_evtq_load(&evt_ctx.evtq.tail, relaxed);
+    int num = 0;
+
+    while (num < max) {
+        sgl_evtq_index_t *seq = &evt_ctx.evtq.seq[pos & SGL_EVENT_QUEUE_SIZE_MASK];
+
+        /* the slot is claimed but the producer has not published it */
+        if (sgl_evtq_load(seq, acquire) != pos + 1) {
+            break;
+        }
+
+        sgl_event_queue_take(pos & SGL_EVENT_QUEUE_SIZE_MASK, &out_event[num++]);
+        sgl_evtq_store(seq, pos + SGL_EVENT_QUEUE_SIZE, release);
+        pos ++;
+    }
+
+    sgl_evtq_store(&evt_ctx.evtq.tail, pos, relaxed);
+    return num;
+}
+
+#else
+
+/**
+ * @brief Put an event into the event queue
+ * @param event The event to be pushed
+ * @return The slot of event, -1 if the queue is full
+ * @note the events must be pushed from one context
+ */
+static int sgl_event_queue_put(const sgl_event_t *event)
+{
+    unsigned int head = sgl_evtq_load(&evt_ctx.evtq.head, relaxed);
+
+    if (unlikely(head - sgl_evtq_load(&evt_ctx.evtq.tail, acquire) >= SGL_EVENT_QUEUE_SIZE)) {
+        return -1;
+    }
+
+    sgl_event_queue_fill(head & SGL_EVENT_QUEUE_SIZE_MASK, event);
+    sgl_evtq_store(&evt_ctx.evtq.head, head + 1, release);
+    return (int)(head & SGL_EVENT_QUEUE_SIZE_MASK);
+}
+
+
+/**
+ * @brief Pop events from the event queue
+ * @param out_event The buffer of events to be popped
+ * @param max The max number of events to be popped
+ * @return The number of events that are popped, 0 if the queue is empty
+ */
+static int sgl_event_queue_pop_batch(sgl_event_t *out_event, int max)
+{
+    unsigned int tail = sgl_evtq_load(&evt_ctx.evtq.tail, relaxed);
+    unsigned int num = sgl_evtq_load(&evt_ctx.evtq.head, acquire) - tail;
+
+    num = sgl_min(num, (unsigned int)max);
+
+    for (unsigned int i = 0; i < num; i++) {
+        sgl_event_queue_take((tail + i) & SGL_EVENT_QUEUE_SIZE_MASK, &out_event[i]);
+    }
+
+    /* the slots are given back to producer at once */
+    sgl_evtq_store(&evt_ctx.evtq.tail, tail + num, release);
+    return (int)num;
+}
+#endif // !CONFIG_SGL_EVENT_QUEUE_MPSC
+
+
 /**
  * @brief Push an event into the event queue
  * @param event The event to be pushed
- * @return 0 on success, -1 on failure
+ * @return none
+ * @note the events must be pushed from one context unless CONFIG_SGL_EVENT_QUEUE_MPSC is enabled
  */
 void sgl_event_queue_push(sgl_event_t event)
 {
-    if (unlikely(sgl_event_queue_is_full())) {
-        SGL_LOG_ERROR("Event queue is full, maybe system is too slow");
+    if (unlikely(sgl_event_queue_put(&event) < 0)) {
+        sgl_evtq_inc(&evt_ctx.evtq.overflow);
         return;
     }
 
-    evt_ctx.evtq.buffer[evt_ctx.evtq.head] = event;
-    evt_ctx.evtq.head = ((evt_ctx.evtq.head + 1) & SGL_EVENT_QUEUE_SIZE_MASK);
+    if (evt_ctx.wake_cb != NULL) {
+        evt_ctx.wake_cb();
+    }
 }
 
 
 /**
- * @brief Pop an event from the event queue
- * @param out_event The event to be popped
- * @return 0 on success, -1 on failure
+ * @brief Check whether there are events in the event queue
+ * @param none
+ * @return true if there are events to be handled, false otherwise
  */
-static inline int sgl_event_queue_pop(sgl_event_t* out_event)
+bool sgl_event_queue_is_pending(void)
 {
-    if (sgl_event_queue_is_empty()) {
-        return -1;
-    }
+#if (CONFIG_SGL_EVENT_QUEUE_MPSC)
+    unsigned int pos = sgl_evtq_load(&evt_ctx.evtq.tail, relaxed);
 
-    *out_event = evt_ctx.evtq.buffer[evt_ctx.evtq.tail];
-    evt_ctx.evtq.tail = ((evt_ctx.evtq.tail + 1) & SGL_EVENT_QUEUE_SIZE_MASK);
-    return 0;
+    return sgl_evtq_load(&evt_ctx.evtq.seq[pos & SGL_EVENT_QUEUE_SIZE_MASK], acquire) == pos + 1;
+#else
+    return sgl_evtq_load(&evt_ctx.evtq.head, acquire) != sgl_evtq_load(&evt_ctx.evtq.tail, relaxed);
+#endif
+}
+
+
+/**
+ * @brief Set the callback that is called when an event is queued
+ * @param wake_cb The callback, NULL to remove it
+ * @return none
+ * @note the callback is called in the context that sends event, such as input thread or interrupt,
+ *       so it should only wake up the thread of sgl task, for example post a semaphore. It must be
+ *       set before the events are sent
+ */
+void sgl_event_set_wake_cb(sgl_event_wake_cb_t wake_cb)
+{
+    evt_ctx.wake_cb = wake_cb;
+}
+
+
+/**
+ * @brief Get the number of events that are dropped because the event queue is full
+ * @param none
+ * @return The number of dropped events since the queue is initialized
+ */
+uint32_t sgl_event_queue_get_overflow(void)
+{
+    return sgl_evtq_load(&evt_ctx.evtq.overflow, relaxed);
 }
 
 
@@ -185,19 +423,163 @@ static bool pos_is_focus_on_obj(sgl_event_pos_t *pos, sgl_rect_t *rect, int16_t
 }
 
 
+#if (CONFIG_SGL_EVENT_HIT_INDEX_MAX)
+/* the screen is split into SGL_HIT_GRID_NUM x SGL_HIT_GRID_NUM cells */
+#define SGL_HIT_GRID_NUM              (8)
+#define SGL_HIT_CELL_NUM              (SGL_HIT_GRID_NUM * SGL_HIT_GRID_NUM)
+
+
 /**
- * @brief check whether the position is clicked on the object
+ * @brief hit index of active page, it is a uniform grid of screen
+ * @page: the page that the index is built for
+ * @obj: objects of all cells, the objects of one cell are stored in draw order
+ * @start: the first object of each cell, the objects of cell i are [start[i], start[i + 1])
+ * @cell_w: width of cell
+ * @cell_h: height of cell
+ * @valid: the index is built successfully, otherwise the object tree is walked
+ */
+static struct sgl_hit_index {
+    struct sgl_obj *page;
+    struct sgl_obj *obj[CONFIG_SGL_EVENT_HIT_INDEX_MAX];
+    uint16_t        start[SGL_HIT_CELL_NUM + 1];
+    int16_t         cell_w;
+    int16_t         cell_h;
+    bool            valid;
+} hit_idx;
+
+
+/**
+ * @brief walk the object tree, and count or store the objects that can be hit in each cell
+ * @param obj the first child of page
+ * @param fill false to count the objects of each cell, true to store them
+ * @return true if success, false if the index is too small
+ * @note an object can be hit only inside the coords of all its ancestors, so the coords are clipped
+ *       by ancestors, the hidden objects are skipped with their children
+ */
+static bool hit_index_walk(struct sgl_obj *obj, bool fill)
+{
+    sgl_area_t clip[SGL_OBJ_DEPTH_MAX];
+    sgl_area_t rect;
+    uint16_t total = 0;
+    int depth = 0, cx, cy;
+
+    clip[0] = (sgl_area_t){ .x1 = 0, .y1 = 0, .x2 = SGL_SCREEN_WIDTH - 1, .y2 = SGL_SCREEN_HEIGHT - 1 };
+
+    while (obj != NULL) {
+        if (!sgl_obj_is_hidden(obj) && sgl_area_clip(&clip[depth], &obj->coords, &rect)) {
+            for (cy = rect.y1 / hit_idx.cell_h; cy <= rect.y2 / hit_idx.cell_h; cy++) {
+                for (cx = rect.x1 / hit_idx.cell_w; cx <= rect.x2 / hit_idx.cell_w; cx++) {
+                    if (fill) {
+                        hit_idx.obj[hit_idx.start[cy * SGL_HIT_GRID_NUM + cx]++] = obj;
+                    }
+                    else if (++total > CONFIG_SGL_EVENT_HIT_INDEX_MAX) {
+                        return false;
+                    }
+                    else {
+                        hit_idx.start[cy * SGL_HIT_GRID_NUM + cx + 1]++;
+                    }
+                }
+            }
+
+            if (obj->child != NULL) {
+                SGL_ASSERT(depth + 1 < SGL_OBJ_DEPTH_MAX);
+                clip[++depth] = rect;
+                obj = obj->child;
+                continue;
+            }
+        }
+
+        /* go to next sibling, and go back to parent when all siblings are finished */
+        while (obj->sibling == NULL) {
+            if (depth == 0) {
+                return true;
+            }
+            depth --;
+            obj = obj->parent;
+        }
+        obj = obj->sibling;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief rebuild the hit index of active page
+ * @param page active page
+ * @return none
+ */
+static void hit_index_build(struct sgl_obj *page)
+{
+    int i;
+
+    hit_idx.page = page;
+    hit_idx.cell_w = (SGL_SCREEN_WIDTH + SGL_HIT_GRID_NUM - 1) / SGL_HIT_GRID_NUM;
+    hit_idx.cell_h = (SGL_SCREEN_HEIGHT + SGL_HIT_GRID_NUM - 1) / SGL_HIT_GRID_NUM;
+    memset(hit_idx.start, 0, sizeof(hit_idx.start));
+    sgl_system.hit_dirty = 0;
+
+    hit_idx.valid = hit_index_walk(page->child, false);
+    if (!hit_idx.valid) {
+        SGL_LOG_TRACE("hit_index_build: hit index is full, fallback to tree walk");
+        return;
+    }
+
+    /* start[i + 1] holds the count of cell i, it is the end of cell i after prefix sum */
+    for (i = 1; i <= SGL_HIT_CELL_NUM; i++) {
+        hit_idx.start[i] += hit_idx.start[i - 1];
+    }
+
+    /* the start of each cell moves to its end while storing, so shift it back after that */
+    hit_index_walk(page->child, true);
+    for (i = SGL_HIT_CELL_NUM; i > 0; i--) {
+        hit_idx.start[i] = hit_idx.start[i - 1];
+    }
+    hit_idx.start[0] = 0;
+}
+
+
+/**
+ * @brief find the top object that is hit by the position in the hit index
+ * @param page active page
  * @param pos The position to be clicked
- * @return The object that is clicked on, NULL if no object is clicked
+ * @return The top object that is hit, NULL if no object is hit
+ * @note an object is hit only if the position is on it and all its ancestors, this is the
+ *       same as the tree walk, so the result is not changed
  */
-static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
+static struct sgl_obj* hit_index_find(struct sgl_obj *page, sgl_event_pos_t *pos)
 {
-    struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj = sgl_screen_act()->child, *find = NULL;
-    int top = 0;
+    struct sgl_obj *obj = NULL;
+    int cell = (pos->y / hit_idx.cell_h) * SGL_HIT_GRID_NUM + pos->x / hit_idx.cell_w;
 
-    if (unlikely(obj == NULL)) {
-        return NULL;
+    for (int i = hit_idx.start[cell + 1] - 1; i >= hit_idx.start[cell]; i--) {
+        for (obj = hit_idx.obj[i]; obj != page; obj = obj->parent) {
+            if (!pos_is_focus_on_obj(pos, &obj->coords, obj->radius)) {
+                break;
+            }
+        }
+
+        if (obj == page) {
+            return hit_idx.obj[i];
+        }
     }
+
+    return NULL;
+}
+#endif // !CONFIG_SGL_EVENT_HIT_INDEX_MAX
+
+
+/**
+ * @brief walk the object tree to find the top object that is hit by the position
+ * @param obj the first child of page
+ * @param pos The position to be clicked
+ * @return The top object that is hit, NULL if no object is hit
+ */
+static struct sgl_obj* click_walk_object(struct sgl_obj *obj, sgl_event_pos_t *pos)
+{
+    struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *find = NULL;
+    int top = 0;
+
     stack[top++] = obj;
 
     while (top > 0) {
@@ -219,6 +601,42 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
         }
     }
 
+    return find;
+}
+
+
+/**
+ * @brief check whether the position is clicked on the object
+ * @param pos The position to be clicked
+ * @return The object that is clicked on, NULL if no object is clicked
+ */
+static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
+{
+    struct sgl_obj *page = sgl_screen_act(), *find = NULL;
+
+    if (unlikely(page->child == NULL)) {
+        return NULL;
+    }
+
+    /* the hit test reads the coords of all objects */
+    sgl_obj_coords_sync(NULL);
+
+#if (CONFIG_SGL_EVENT_HIT_INDEX_MAX)
+    /* the index is rebuilt lazily after the object tree is changed */
+    if (sgl_system.hit_dirty || hit_idx.page != page) {
+        hit_index_build(page);
+    }
+
+    if (hit_idx.valid && pos->x >= 0 && pos->x < SGL_SCREEN_WIDTH && pos->y >= 0 && pos->y < SGL_SCREEN_HEIGHT) {
+        find = hit_index_find(page, pos);
+    }
+    else {
+        find = click_walk_object(page->child, pos);
+    }
+#else
+    find = click_walk_object(page->child, pos);
+#endif
+
     /**
      * if the object is clickable, return it, otherwise return its parent 
      * because the object may be a label attached to the object
@@ -236,6 +654,7 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
  * @param pos The position to be handled
  * @param type The type of the event
  * @return none
+ * @note the position events must be sent from one context
  */
 void sgl_event_send_pos(sgl_event_pos_t pos, sgl_event_type_t type)
 {
@@ -245,11 +664,33 @@ void sgl_event_send_pos(sgl_event_pos_t pos, sgl_event_type_t type)
         .pos = pos,
     };
 
-    if (type == SGL_EVENT_PRESSED) {
-        evt_ctx.last_touch = pos;
+#if (SGL_EVENT_MOTION_MERGE)
+    unsigned int motion = 0;
+    int slot = evt_ctx.motion_slot;
+
+    /* move the queued motion if it is not taken, so it is handled once in the frame */
+    if (type == SGL_EVENT_MOTION && slot >= 0) {
+        motion = sgl_evtq_load(&evt_ctx.evtq.motion[slot], relaxed);
+        while (motion & SGL_EVENT_MOTION_VALID) {
+            if (sgl_evtq_cas(&evt_ctx.evtq.motion[slot], &motion, sgl_event_motion_pack(pos))) {
+                return;
+            }
+        }
+    }
+
+    slot = sgl_event_queue_put(&event);
+    if (unlikely(slot < 0)) {
+        sgl_evtq_inc(&evt_ctx.evtq.overflow);
+    }
+    else if (evt_ctx.wake_cb != NULL) {
+        evt_ctx.wake_cb();
     }
 
+    /* the press and release must not be passed by motion */
+    evt_ctx.motion_slot = (type == SGL_EVENT_MOTION) ? slot : -1;
+#else
     sgl_event_queue_push(event);
+#endif
 }
 
 
@@ -289,71 +730,97 @@ static void sgl_get_move_info(sgl_event_t *evt)
 
 
 /**
- * @brief All event task in SGL, this function will traverse all elements in the event queue, 
- *        respond to each element with an event, so that all events will trigger and point to the 
- *        corresponding callback function
- * @param none
+ * @brief Handle one event, the event is sent to the callback of object
+ * @param evt event to be handled
  * @return none
-*/
-void sgl_event_task(void)
+ */
+static void sgl_event_handle(sgl_event_t *evt)
 {
-    sgl_event_t evt;
-    struct sgl_obj *obj = NULL;
+    struct sgl_obj *obj = evt->obj;
 
-    /* Get event from event queue */
-    while (sgl_event_queue_pop(&evt) == 0) {
-        obj = evt.obj;
-
-        /* if obj is NULL, it means the event from the input device */
-        if (obj == NULL) {
-            if (evt.type != SGL_EVENT_MOTION) {
-                obj = click_detect_object(&evt.pos);
-            } else {
-                obj = evt_ctx.last_click;
-                sgl_get_move_info(&evt);
+    /* if obj is NULL, it means the event from the input device */
+    if (obj == NULL) {
+        if (evt->type != SGL_EVENT_MOTION) {
+            if (evt->type == SGL_EVENT_PRESSED) {
+                evt_ctx.last_touch = evt->pos;
             }
+            obj = click_detect_object(&evt->pos);
+        } else {
+            obj = evt_ctx.last_click;
+            sgl_get_move_info(evt);
         }
+    }
 
-        if (obj) {
-            evt.pos.x = sgl_clamp(evt.pos.x, obj->coords.x1, obj->coords.x2);
-            evt.pos.y = sgl_clamp(evt.pos.y, obj->coords.y1, obj->coords.y2);
+    if (obj) {
+        sgl_obj_coords_sync(obj);
+        evt->pos.x = sgl_clamp(evt->pos.x, obj->coords.x1, obj->coords.x2);
+        evt->pos.y = sgl_clamp(evt->pos.y, obj->coords.y1, obj->coords.y2);
 
-            if (evt.type == SGL_EVENT_PRESSED) {
-                if (obj->pressed) {
-                    continue;
-                }
-                obj->pressed = true;
-                evt_ctx.last_click = obj;
+        if (evt->type == SGL_EVENT_PRESSED) {
+            if (obj->pressed) {
+                return;
             }
-            else if (evt.type == SGL_EVENT_RELEASED) {
-                if (!obj->pressed) {
-                    if (evt_ctx.last_click && evt_ctx.last_click != obj) {
-                        evt.obj = evt_ctx.last_click;
-                        sgl_event_queue_push(evt);
-                    }
-                    continue;
+            obj->pressed = true;
+            evt_ctx.last_click = obj;
+        }
+        else if (evt->type == SGL_EVENT_RELEASED) {
+            if (!obj->pressed) {
+                /* the pressed object lost the release, it is sent to pressed object */
+                if (evt_ctx.last_click && evt_ctx.last_click != obj) {
+                    evt->obj = evt_ctx.last_click;
+                    sgl_event_handle(evt);
                 }
-                obj->pressed = false;
-                evt_ctx.last_click = NULL;
+                return;
             }
+            obj->pressed = false;
+            evt_ctx.last_click = NULL;
+        }
 
-            SGL_ASSERT(obj->construct_fn);
-            evt.param = obj->event_data;
-            evt.obj = obj;
-            obj->construct_fn(NULL, obj, &evt);
+        SGL_ASSERT(obj->construct_fn);
+        evt->param = sgl_obj_get_event_data(obj);
+        evt->obj = obj;
+        obj->construct_fn(NULL, obj, evt);
 
-            /* call user event function */
-            if(obj->event_fn) {
-                obj->event_fn(&evt);
-            }
+        /* call user event function */
+        sgl_obj_call_event_cb(obj, evt);
+    }
+    else {
+        SGL_LOG_TRACE("pos is out of object or no event_lost, skip event");
+        if (evt->type == SGL_EVENT_RELEASED && evt_ctx.last_click != NULL) {
+            evt->obj = evt_ctx.last_click;
+            sgl_event_handle(evt);
         }
-        else {
-            SGL_LOG_TRACE("pos is out of object or no event_lost, skip event");
-            if (evt.type == SGL_EVENT_RELEASED && evt_ctx.last_click != NULL) {
-                evt.obj = evt_ctx.last_click;
-                sgl_event_queue_push(evt);
-            }
+    }
+}
+
+
+/**
+ * @brief All event task in SGL, this function will traverse all elements in the event queue, 
+ *        respond to each element with an event, so that all events will trigger and point to the 
+ *        corresponding callback function
+ * @param none
+ * @return none
+ * @note the events are taken in batches and at most one queue of events is handled, so the
+ *       input context that keeps sending events does not block the frame
+*/
+void sgl_event_task(void)
+{
+    sgl_event_t batch[SGL_EVENT_BATCH_SIZE];
+    uint32_t overflow = sgl_event_queue_get_overflow();
+    int budget = SGL_EVENT_QUEUE_SIZE, num = 0;
+
+    if (unlikely(overflow != evt_ctx.last_overflow)) {
+        SGL_LOG_WARN("Event queue is full, %d events are dropped, maybe system is too slow",
+                     (int)(overflow - evt_ctx.last_overflow));
+        evt_ctx.last_overflow = overflow;
+    }
+
+    /* Get event from event queue */
+    while (budget > 0 && (num = sgl_event_queue_pop_batch(batch, sgl_min(budget, SGL_EVENT_BATCH_SIZE))) > 0) {
+        for (int i = 0; i < num; i++) {
+            sgl_event_handle(&batch[i]);
         }
+        budget -= num;
     }
 }
 
@@ -170,8 +170,15 @@ uint16_t sgl_sqrt(uint32_t x)
     uint32_t rem = 0;
     uint32_t root = 0;
     uint32_t divisor = 0;
+    int i = 0;
 
-    for (int i=0; i<16; i++) {
+    /* the leading zero bit pairs of x keep root zero, so they are skipped */
+    if ((x & 0xFFFF0000) == 0) { i += 8; x <<= 16; }
+    if ((x & 0xFF000000) == 0) { i += 4; x <<= 8; }
+    if ((x & 0xF0000000) == 0) { i += 2; x <<= 4; }
+    if ((x & 0xC0000000) == 0) { i += 1; x <<= 2; }
+
+    for (; i<16; i++) {
         root <<= 1;
         rem = ((rem << 2) + (x >> 30));
         x <<= 2;
@@ -104,7 +104,7 @@ static void sgl_logo_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
 
 sgl_obj_t* sgl_logo_create(sgl_obj_t* parent)
 {
-    sgl_logo_t *logo = sgl_malloc(sizeof(sgl_logo_t));
+    sgl_logo_t *logo = sgl_slab_alloc(sizeof(sgl_logo_t));
     if (logo == NULL) {
         SGL_LOG_ERROR("sgl_logo_create: malloc failed");
         return NULL;
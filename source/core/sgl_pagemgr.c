@@ -0,0 +1,269 @@
+/* source/core/sgl_pagemgr.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * The page manager builds the registered pages when they are loaded, and keeps the built pages in
+ * a LRU list, the most recently loaded page is at the front. When the used memory is larger than
+ * budget, the pages at the tail are evicted, so the application does not choose between keeping
+ * all pages in memory and building the page at every switch.
+ */
+
+#include <sgl_core.h>
+#include <sgl_anim.h>
+#include <sgl_pagemgr.h>
+#include <sgl_list.h>
+#include <sgl_log.h>
+#include <sgl_mm.h>
+
+
+#if (CONFIG_SGL_PAGEMGR_NUM)
+
+/**
+ * @ops:       callbacks of page
+ * @user_data: user data that is passed to callbacks
+ * @page:      page object, NULL if the page is not resident
+ * @node:      node of LRU list, it is linked only when the page is resident
+ * @saved:     the state of page is saved by save callback when it is evicted
+ */
+typedef struct sgl_pagemgr_slot {
+    const sgl_page_ops_t  *ops;
+    void                  *user_data;
+    sgl_obj_t             *page;
+    sgl_list_node_t       node;
+    bool                  saved;
+} sgl_pagemgr_slot_t;
+
+
+static struct sgl_pagemgr {
+    sgl_pagemgr_slot_t    slot[CONFIG_SGL_PAGEMGR_NUM];
+    sgl_list_node_t       lru;
+    size_t                budget;
+} sgl_pagemgr = {
+    .lru = { .prev = &sgl_pagemgr.lru, .next = &sgl_pagemgr.lru },
+    .budget = CONFIG_SGL_PAGEMGR_BUDGET,
+};
+
+
+/**
+ * @brief get the slot of id
+ * @param id: id of page
+ * @return slot of page, NULL if the id is not registered
+ */
+static sgl_pagemgr_slot_t* sgl_pagemgr_slot(int id)
+{
+    if (id < 0 || id >= CONFIG_SGL_PAGEMGR_NUM || sgl_pagemgr.slot[id].ops == NULL) {
+        SGL_LOG_WARN("sgl_pagemgr: invalid page id %d", id);
+        return NULL;
+    }
+
+    return &sgl_pagemgr.slot[id];
+}
+
+
+/**
+ * @brief free a resident page, the state of page is saved before
+ * @param slot: slot of page
+ * @return none
+ */
+static void sgl_pagemgr_release(sgl_pagemgr_slot_t *slot)
+{
+    if (slot->ops->save != NULL) {
+        slot->ops->save(slot->page, slot->user_data);
+        slot->saved = true;
+    }
+
+    sgl_list_del_node(&slot->node);
+
+#if (CONFIG_SGL_ANIMATION)
+    /* the animations of page must not step the freed objects */
+    sgl_anim_remove_obj(slot->page);
+#endif
+
+    /* the memory is given back at once, so the budget is checked again */
+    sgl_obj_free(slot->page);
+    slot->page = NULL;
+}
+
+
+/**
+ * @brief get the used memory that counts against budget
+ * @param none
+ * @return used size of memory in bytes
+ * @note the free slots of slab are kept in heap, but they are reused by the next page, so they
+ *       are not counted, otherwise the freed pages never bring the used memory down
+ */
+static inline size_t sgl_pagemgr_used(void)
+{
+    size_t used = sgl_mm_get_used_size();
+    size_t cached = sgl_slab_get_free_size();
+
+    return used > cached ? used - cached : 0;
+}
+
+
+/**
+ * @brief evict the pages that are not used for the longest time until the used memory is in budget
+ * @param none
+ * @return none
+ */
+static void sgl_pagemgr_shrink(void)
+{
+    sgl_list_node_t *node = sgl_pagemgr.lru.prev;
+    sgl_pagemgr_slot_t *slot = NULL;
+
+    if (sgl_pagemgr.budget == 0) {
+        return;
+    }
+
+    while (node != &sgl_pagemgr.lru && sgl_pagemgr_used() > sgl_pagemgr.budget) {
+        slot = sgl_container_of(node, sgl_pagemgr_slot_t, node);
+        node = node->prev;
+
+        if (slot->page != sgl_screen_act()) {
+            sgl_pagemgr_release(slot);
+        }
+    }
+}
+
+
+/**
+ * @brief register a page into page manager, the page is not built until it is loaded
+ * @param ops: callbacks of page, it must be kept valid by application
+ * @param user_data: user data that is passed to callbacks
+ * @return id of page, -1 if there is no free slot
+ */
+int sgl_pagemgr_register(const sgl_page_ops_t *ops, void *user_data)
+{
+    SGL_ASSERT(ops != NULL && ops->build != NULL);
+
+    for (int i = 0; i < CONFIG_SGL_PAGEMGR_NUM; i++) {
+        if (sgl_pagemgr.slot[i].ops == NULL) {
+            sgl_pagemgr.slot[i].ops = ops;
+            sgl_pagemgr.slot[i].user_data = user_data;
+            sgl_pagemgr.slot[i].page = NULL;
+            sgl_pagemgr.slot[i].saved = false;
+            sgl_list_init(&sgl_pagemgr.slot[i].node);
+            return i;
+        }
+    }
+
+    SGL_LOG_ERROR("sgl_pagemgr_register: no free slot, please increase CONFIG_SGL_PAGEMGR_NUM");
+    return -1;
+}
+
+
+/**
+ * @brief load a page as active screen, the page is built if it is not resident
+ * @param id: id of page
+ * @return page object, NULL if the page can not be built
+ * @note the pages that are not used for the longest time are evicted while the used memory is
+ *       larger than budget, the active page is never evicted
+ */
+sgl_obj_t* sgl_pagemgr_load(int id)
+{
+    sgl_pagemgr_slot_t *slot = sgl_pagemgr_slot(id);
+
+    if (slot == NULL) {
+        return NULL;
+    }
+
+    if (slot->page == NULL) {
+        /* make room for the new page before it is built */
+        sgl_pagemgr_shrink();
+
+        slot->page = sgl_obj_create(NULL);
+        if (slot->page == NULL) {
+            SGL_LOG_ERROR("sgl_pagemgr_load: create page failed");
+            return NULL;
+        }
+
+        slot->ops->build(slot->page, slot->user_data);
+
+        if (slot->saved && slot->ops->restore != NULL) {
+            slot->ops->restore(slot->page, slot->user_data);
+        }
+        slot->saved = false;
+    }
+    else {
+        sgl_list_del_node(&slot->node);
+    }
+
+    sgl_list_add_node_at_front(&sgl_pagemgr.lru, &slot->node);
+    sgl_screen_load(slot->page);
+
+    /* the previous page may be evicted now */
+    sgl_pagemgr_shrink();
+
+    return slot->page;
+}
+
+
+/**
+ * @brief get the page object of id
+ * @param id: id of page
+ * @return page object, NULL if the page is not resident
+ */
+sgl_obj_t* sgl_pagemgr_get(int id)
+{
+    sgl_pagemgr_slot_t *slot = sgl_pagemgr_slot(id);
+
+    return slot != NULL ? slot->page : NULL;
+}
+
+
+/**
+ * @brief evict a page, its state is saved and all its objects are freed
+ * @param id: id of page
+ * @return none
+ * @note the active page can not be evicted, the managed pages must not be deleted by sgl_obj_delete
+ */
+void sgl_pagemgr_evict(int id)
+{
+    sgl_pagemgr_slot_t *slot = sgl_pagemgr_slot(id);
+
+    if (slot == NULL || slot->page == NULL) {
+        return;
+    }
+
+    if (slot->page == sgl_screen_act()) {
+        SGL_LOG_WARN("sgl_pagemgr_evict: the active page can not be evicted");
+        return;
+    }
+
+    sgl_pagemgr_release(slot);
+}
+
+
+/**
+ * @brief set memory budget of page manager
+ * @param budget: max used size of memory in bytes, 0 means the pages are never evicted by budget
+ * @return none
+ */
+void sgl_pagemgr_set_budget(size_t budget)
+{
+    sgl_pagemgr.budget = budget;
+    sgl_pagemgr_shrink();
+}
+
+#endif // ! CONFIG_SGL_PAGEMGR_NUM
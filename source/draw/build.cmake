@@ -30,4 +30,6 @@ set(SGL_SOURCE
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_text.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_ring.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_icon.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_span.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_mask.c
 )
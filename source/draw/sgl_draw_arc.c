@@ -74,7 +74,6 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
     uint32_t temp;
     uint8_t alpha = SGL_ALPHA_MIN, max = SGL_ALPHA_MIN;
     sgl_arc_dot_t *p = dot;
-    int32_t rate = (0xff00) / (dot->rmax - dot->r2);
 
     for (int k = 0; k < 2; k++, p++) {
         int x = ax > p->cx ? ax - p->cx : p->cx-ax;
@@ -87,7 +86,7 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
             }
             else if (temp > p->r2) {
                 if(dot->outer==0) {
-                    dot->outer = rate;
+                    dot->outer = (0xff00) / (dot->rmax - dot->r2);
                 }
                 alpha = (p->rmax - temp) * dot->outer >> 8;
             }
@@ -101,33 +100,258 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
 }
 
 
+/**
+ * @brief the state of arc that is shared by the rows
+ * @desc: arc description
+ * @dot: the round caps of smooth modes
+ * @flag: 255 for full circle, 1 if the arc is larger than half circle, otherwise 0
+ * @sx, sy, ex, ey: direction of start and end rays
+ */
+typedef struct sgl_arc_ctx {
+    sgl_draw_arc_t   *desc;
+    sgl_arc_dot_t    dot[2];
+    int32_t          in_r2;
+    int32_t          in_r2_max;
+    int32_t          out_r2;
+    int32_t          out_r2_max;
+    int32_t          rate;
+    int32_t          rate2;
+    int32_t          sx, sy, ex, ey;
+    uint8_t          flag;
+} sgl_arc_ctx_t;
+
+
+/* the pixels nearer than this to a ray are blended one by one, it is the edge width of cap */
+#define  SGL_ARC_RAY_EDGE                (256)
+
+
+/**
+ * @brief get the anti-aliasing alpha of pixel in annulus
+ * @param ctx arc state
+ * @param real_r2 square of the distance from pixel to center
+ * @return alpha of pixel
+ */
+static inline int arc_edge_alpha(sgl_arc_ctx_t *ctx, int real_r2)
+{
+    if (real_r2 < ctx->in_r2) {
+        return (real_r2 - ctx->in_r2_max) * ctx->rate >> 8;
+    }
+    else if (real_r2 > ctx->out_r2) {
+        return (ctx->out_r2_max - real_r2) * ctx->rate2 >> 8;
+    }
+    return SGL_ALPHA_MAX;
+}
+
+
+/**
+ * @brief check the pixel is between start and end rays
+ * @param ctx arc state
+ * @param dx x distance from pixel to center
+ * @param dy y distance from pixel to center
+ * @param ds output distance to start ray
+ * @param de output distance to end ray
+ * @return 1 if the pixel is in the arc, otherwise 0
+ */
+static inline uint8_t arc_in_range(sgl_arc_ctx_t *ctx, int32_t dx, int32_t dy, int32_t *ds, int32_t *de)
+{
+    if (ctx->flag == 255) {
+        return 1;
+    }
+
+    *ds = (dx *  ctx->sy - dy *  ctx->sx);
+    *de = (dy *  ctx->ex - dx *  ctx->ey);
+    return ctx->flag > 0 ? (*ds > 0 || *de > 0) : (*ds >= 0 && *de >= 0);
+}
+
+
+/**
+ * @brief blend one pixel of annulus, the caps and the pixels out of arc are computed here
+ * @param ctx arc state
+ * @param blend point to pixel
+ * @param x x of pixel
+ * @param y y of pixel
+ * @return none
+ */
+static void arc_blend_pixel(sgl_arc_ctx_t *ctx, sgl_color_t *blend, int x, int y)
+{
+    sgl_draw_arc_t *desc = ctx->desc;
+    int32_t dx = x - desc->cx, dy = y - desc->cy;
+    int32_t ds = 0, de = 0, sd = 0, ed = 0;
+    int edge_alpha = arc_edge_alpha(ctx, sgl_pow2(dx) + sgl_pow2(dy));
+    uint8_t in_range = arc_in_range(ctx, dx, dy, &ds, &de);
+    sgl_color_t tmp_color = desc->color;
+
+    if (in_range && edge_alpha == SGL_ALPHA_MAX) {
+        *blend = desc->alpha == SGL_ALPHA_MAX ? desc->color : sgl_color_mixer(desc->color, *blend, desc->alpha);
+        return;
+    }
+
+    if (!in_range) {
+        switch (desc->mode) {
+        case SGL_ARC_MODE_NORMAL:
+            sd = sgl_xy_has_component(dx,dy, ctx->sx, ctx->sy) ? sgl_abs(ds) : 256;
+            ed = sgl_xy_has_component(dx,dy, ctx->ex, ctx->ey) ? sgl_abs(de) : 256;
+            dx =  sgl_min(sd, ed);
+            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, sgl_min(255 - dx, edge_alpha)) : *blend;
+            break;
+
+        case SGL_ARC_MODE_RING:
+            sd = sgl_xy_has_component(dx,dy, ctx->sx, ctx->sy) ? sgl_abs(ds) : 256;
+            ed = sgl_xy_has_component(dx,dy, ctx->ex, ctx->ey) ? sgl_abs(de) : 256;
+            dx =  sgl_min(sd, ed);
+            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, sgl_min(255 - dx, edge_alpha)) : desc->bg_color;
+            break;
+
+        case SGL_ARC_MODE_NORMAL_SMOOTH:
+            dx = arc_get_dot(ctx->dot, x, y);
+            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, dx) : desc->color;
+            break;
+
+        case SGL_ARC_MODE_RING_SMOOTH:
+            dx = arc_get_dot(ctx->dot, x, y);
+            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, dx) : desc->color;
+            break;
+
+        default: break;
+        }
+    }
+
+    *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(tmp_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(tmp_color, *blend, edge_alpha), *blend, desc->alpha);
+}
+
+
+/**
+ * @brief get the x range of a row where a ray may change the pixels, the range is a bit larger
+ * @param a change of distance to ray for one pixel in x
+ * @param b distance to ray at center x
+ * @param cx center x of arc
+ * @param win output range
+ * @return none
+ */
+static void arc_ray_window(int32_t a, int32_t b, int cx, int win[2])
+{
+    int32_t lo, hi;
+
+    if (a == 0) {
+        /* the ray is horizontal, the row is near it or not at all */
+        win[0] = sgl_abs(b) < SGL_ARC_RAY_EDGE ? INT16_MIN : 1;
+        win[1] = sgl_abs(b) < SGL_ARC_RAY_EDGE ? INT16_MAX : 0;
+        return;
+    }
+
+    lo = (-SGL_ARC_RAY_EDGE - b) / a;
+    hi = (SGL_ARC_RAY_EDGE - b) / a;
+    win[0] = cx + sgl_min(lo, hi) - 1;
+    win[1] = cx + sgl_max(lo, hi) + 1;
+}
+
+
+/**
+ * @brief blend a run of annulus row, the pixels near rays and caps are blended one by one, the
+ *        others are all in arc or all out of arc, so they are blended without angle tests
+ * @param ctx arc state
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param win ranges of row that are blended one by one
+ * @param num number of ranges
+ * @param x1 first x of run
+ * @param x2 last x of run
+ * @param y y of row
+ * @param solid the run is between edges of annulus
+ * @return none
+ */
+static void arc_blend_run(sgl_arc_ctx_t *ctx, sgl_color_t *buf, sgl_area_t *clip, int win[][2], int num, int x1, int x2, int y, bool solid)
+{
+    sgl_draw_arc_t *desc = ctx->desc;
+    sgl_color_t *blend = NULL;
+    sgl_color_t color;
+    int32_t ds = 0, de = 0;
+    int end, last, edge_alpha;
+
+    x1 = sgl_max(x1, clip->x1);
+    x2 = sgl_min(x2, clip->x2);
+
+    for (int x = x1; x <= x2; x = end + 1) {
+        /* the ranges may be overlapped, the near part from x ends at the end of last overlapped range */
+        end = x - 1;
+        do {
+            last = end;
+            for (int i = 0; i < num; i++) {
+                if (win[i][0] <= end + 1 && win[i][1] > end) {
+                    end = win[i][1];
+                }
+            }
+        } while (end != last);
+
+        if (end >= x) {
+            end = sgl_min(end, x2);
+            blend = buf + (x - clip->x1);
+            for (int k = x; k <= end; k++, blend++) {
+                arc_blend_pixel(ctx, blend, k, y);
+            }
+            continue;
+        }
+
+        end = x2;
+        for (int i = 0; i < num; i++) {
+            if (win[i][0] > x) {
+                end = sgl_min(end, win[i][0] - 1);
+            }
+        }
+
+        if (arc_in_range(ctx, x - desc->cx, y - desc->cy, &ds, &de)) {
+            color = desc->color;
+        }
+        else if (desc->mode == SGL_ARC_MODE_RING || desc->mode == SGL_ARC_MODE_RING_SMOOTH) {
+            color = desc->bg_color;
+        }
+        else {
+            /* the pixels out of arc and far from caps are not changed */
+            continue;
+        }
+
+        if (solid) {
+            sgl_draw_hspan(buf, clip, x, end, color, desc->alpha);
+            continue;
+        }
+
+        blend = buf + (x - clip->x1);
+        for (int k = x; k <= end; k++, blend++) {
+            edge_alpha = arc_edge_alpha(ctx, sgl_pow2(k - desc->cx) + sgl_pow2(y - desc->cy));
+            *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, desc->alpha);
+        }
+    }
+}
+
+
 /**
  * @brief draw an arc with alpha
  * @param surf pointer to surface
  * @param area pointer to area
  * @param desc pointer to arc description
  * @return none
+ * @note every row of annulus is split into edges and solid part once, and the x ranges where
+ *       the start and end rays or the caps cross the row are found, only the pixels in them are
+ *       tested by angle, the others are drawn as spans
  */
 void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
 {
-    int y2 = 0, real_r2 = 0, edge_alpha = 0;
-    int in_r2 = sgl_pow2(desc->radius_in);
-    int out_r2 = sgl_pow2(desc->radius_out);
-    int inv_inner = 0, inv_outer = 0;
-    sgl_arc_dot_t arc_dot[2];
-
-    int in_r2_max = sgl_pow2(desc->radius_in - 1);
-    int out_r2_max = sgl_pow2(desc->radius_out + 1);
-    int32_t rate = (0xff00) / (in_r2 - in_r2_max);
-    int32_t rate2 = (0xff00) / (out_r2_max - out_r2);
-
-    sgl_color_t *buf = NULL, *blend = NULL;
-    int32_t dx, dy;
-    uint8_t flag = 0xff, in_range;
-    int32_t ds = 0, de = 0, sd = 0, ed = 0;
-    int32_t sx = 0, sy = 0, ex = 0, ey = 0;
-    sgl_color_t tmp_color;
+    sgl_arc_ctx_t ctx = {
+        .desc = desc,
+        .dot = { { 0 }, { 0 } },
+        .in_r2 = sgl_pow2(desc->radius_in),
+        .in_r2_max = sgl_pow2(desc->radius_in - 1),
+        .out_r2 = sgl_pow2(desc->radius_out),
+        .out_r2_max = sgl_pow2(desc->radius_out + 1),
+        .flag = 0xff,
+    };
+    sgl_draw_mask_row_t row;
+    sgl_color_t *buf = NULL;
     sgl_area_t clip = SGL_AREA_MAX;
+    int win[4][2], num = 0, dy = 0, lo = 0, hi = 0;
+
+    ctx.rate = (0xff00) / (ctx.in_r2 - ctx.in_r2_max);
+    ctx.rate2 = (0xff00) / (ctx.out_r2_max - ctx.out_r2);
 
     sgl_surf_clip_area_return(surf, area, &clip);
 
@@ -143,102 +367,54 @@ void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
     }
 
     if (desc->start_angle != 0 || desc->end_angle != 360) {
-        flag = (desc->end_angle - desc->start_angle > 180) ? 1 : 0;
-        sx = sgl_sin(desc->start_angle);
-        sy = -sgl_cos(desc->start_angle);
-        ex = sgl_sin(desc->end_angle);
-        ey = -sgl_cos(desc->end_angle);
+        ctx.flag = (desc->end_angle - desc->start_angle > 180) ? 1 : 0;
+        ctx.sx = sgl_sin(desc->start_angle);
+        ctx.sy = -sgl_cos(desc->start_angle);
+        ctx.ex = sgl_sin(desc->end_angle);
+        ctx.ey = -sgl_cos(desc->end_angle);
 
         if (desc->mode == SGL_ARC_MODE_NORMAL_SMOOTH || desc->mode == SGL_ARC_MODE_RING_SMOOTH) {
-            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &arc_dot[0], sx, sy);
-            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &arc_dot[1], ex, ey);
+            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &ctx.dot[0], ctx.sx, ctx.sy);
+            arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &ctx.dot[1], ctx.ex, ctx.ey);
         }
 
-        sx = sx >> 7;
-        sy = sy >> 7;
-        ex = ex >> 7;
-        ey = ey >> 7;
+        ctx.sx = ctx.sx >> 7;
+        ctx.sy = ctx.sy >> 7;
+        ctx.ex = ctx.ex >> 7;
+        ctx.ey = ctx.ey >> 7;
     }
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
         dy = y - desc->cy;
-        y2 = sgl_pow2(dy);
-        blend = buf;
+        sgl_draw_mask_row(NULL, desc->radius_out, desc->radius_in, dy, &row);
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx = x - desc->cx;
-            real_r2 = sgl_pow2(x - desc->cx) + y2;
+        num = 0;
+        if (ctx.flag != 255) {
+            arc_ray_window(ctx.sy, -dy * ctx.sx, desc->cx, win[num++]);
+            arc_ray_window(-ctx.ey, dy * ctx.ex, desc->cx, win[num++]);
 
-            if (real_r2 >= out_r2_max) {
-                if (x > desc->cx) {
-                    blend++;
-                    break;
-                }
-                continue;
-            }
-            if (real_r2 < in_r2_max) {
-                if (x < desc->cx) {
-                    blend += ((desc->cx - x) * 2);
-                    x = desc->cx * 2 - x;
+            /* the round caps are blended by the distance to their centers */
+            for (int k = 0; k < 2; k++) {
+                if (sgl_abs(y - ctx.dot[k].cy) < ctx.dot[k].r) {
+                    win[num][0] = ctx.dot[k].cx - ctx.dot[k].r + 1;
+                    win[num][1] = ctx.dot[k].cx + ctx.dot[k].r - 1;
+                    num++;
                 }
-                continue;
-            }
-            if (real_r2 < in_r2 ) {
-                if(inv_inner == 0) {
-                    inv_inner = rate;
-                }
-                edge_alpha  = (real_r2 - in_r2_max) * inv_inner >> 8;
-            }
-            else if (real_r2 > out_r2) {
-                if(inv_outer == 0) {
-                    inv_outer = rate2;
-                }
-                edge_alpha = (out_r2_max - real_r2) * inv_outer >> 8;
-            }
-            else {
-                edge_alpha = SGL_ALPHA_MAX;
             }
+        }
 
-            tmp_color = desc->color;
-            if (flag != 255) {
-                ds = (dx *  sy - dy *  sx);
-                de = (dy *  ex - dx *  ey);
-                in_range =  flag > 0 ? (ds > 0 || de >0) : (ds >= 0 && de >= 0);
-                if (!in_range) {
-
-                    switch (desc->mode) {
-                    case SGL_ARC_MODE_NORMAL:
-                        sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
-                        ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
-                        dx =  sgl_min(sd, ed);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, sgl_min(255 - dx, edge_alpha)) : *blend;
-                        break;
-
-                    case SGL_ARC_MODE_RING:
-                        sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
-                        ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
-                        dx =  sgl_min(sd, ed);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, sgl_min(255 - dx, edge_alpha)) : desc->bg_color;
-                        break;
-
-                    case SGL_ARC_MODE_NORMAL_SMOOTH:
-                        dx = arc_get_dot(arc_dot, x, y);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, dx) : desc->color;
-                        break;
-
-                    case SGL_ARC_MODE_RING_SMOOTH:
-                        dx = arc_get_dot(arc_dot, x, y);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, dx) : desc->color;
-                        break;
-
-                    default: break;
-                    }
-                }
-            }
+        /* the inner edge, solid part and outer edge of both sides, the center is on the left */
+        for (int part = 1; part <= 3; part++) {
+            lo = row.half[part - 1];
+            hi = row.half[part];
 
-            *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(tmp_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(tmp_color, *blend, edge_alpha), *blend, desc->alpha);
+            if (hi > lo) {
+                arc_blend_run(&ctx, buf, &clip, win, num, desc->cx - hi, desc->cx - sgl_max(lo + 1, 0), y, part == 2);
+                arc_blend_run(&ctx, buf, &clip, win, num, desc->cx + sgl_max(lo + 1, 1), desc->cx + hi, y, part == 2);
+            }
         }
+
         buf += surf->w;
     }
 }
@@ -37,11 +37,13 @@
  * @param color Color of the circle
  * @param alpha Alpha of the circle
  * @return none
+ * @note the edges of every row are computed once or got from mask cache, the inner pixels are
+ *       drawn as one span and only the anti-aliasing pixels of edge are blended by coverage
  */
 void sgl_draw_fill_circle(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius, sgl_color_t color, uint8_t alpha)
 {
     sgl_area_t clip = SGL_AREA_MAX;
-    sgl_color_t *buf = NULL, *blend = NULL;
+    sgl_color_t *buf = NULL;
 
     sgl_surf_clip_area_return(surf, area, &clip);
 
@@ -55,32 +57,17 @@ void sgl_draw_fill_circle(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_
         return;
     }
 
-    int y2 = 0, real_r2 = 0, edge_alpha = 0;
-    int r2 = sgl_pow2(radius);
-    int r2_edge = sgl_pow2(radius + 1);
+    const sgl_draw_mask_t *mask = sgl_draw_mask_get(surf, radius, -1);
+    sgl_draw_mask_row_t row;
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        y2 = sgl_pow2(y - cy);
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
-
-            if (real_r2 >= r2_edge) {
-                if(x > cx)
-                    break;
-                continue;
-            }
-            else if (real_r2 >= r2) {
-                edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
-            }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-            }
-        }
+        sgl_draw_mask_row(mask, radius, -1, y - cy, &row);
+        sgl_draw_mask_hline(buf, &clip, &row, cx, color, alpha);
         buf += surf->w;
     }
+
+    sgl_draw_mask_put(mask);
 }
 
 
@@ -162,53 +149,39 @@ void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx,
  * @param border_width Width of the border
  * @param alpha Alpha of the circle
  * @return none
+ * @note every row is a ring row whose inner radius is the inner side of border, the fill and the
+ *       border are drawn as spans and only the pixels of two edges are blended by coverage, which
+ *       is got from mask cache
  */
 void sgl_draw_fill_circle_with_border(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius, sgl_color_t color, sgl_color_t border_color, int16_t border_width, uint8_t alpha)
 {
     int radius_in = sgl_max(radius - border_width + 1, 0);
-    int y2 = 0, real_r2 = 0;
-    int in_r2 = sgl_pow2(radius_in);
-    int out_r2 = sgl_pow2(radius);
-    sgl_color_t *buf = NULL, *blend = NULL;
-
-    int in_r2_max = sgl_pow2(radius_in - 1);
-    int out_r2_max = sgl_pow2(radius + 1);
-    uint8_t edge_alpha = 0;
+    sgl_color_t *buf = NULL;
     sgl_area_t clip = SGL_AREA_MAX;
+    sgl_draw_mask_row_t row;
 
     sgl_surf_clip_area_return(surf, area, &clip);
 
-    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        y2 = sgl_pow2(y - cy);
+    sgl_area_t c_rect = {
+        .x1 = cx - radius,
+        .x2 = cx + radius,
+        .y1 = cy - radius,
+        .y2 = cy + radius
+    };
+    if (!sgl_area_selfclip(&clip, &c_rect)) {
+        return;
+    }
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
+    const sgl_draw_mask_t *mask = sgl_draw_mask_get(surf, radius, radius_in);
 
-            if (real_r2 >= out_r2_max) {
-                if (x > cx)
-                    break;
-                continue;
-            }
-            if (real_r2 < in_r2_max) {
-                *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                continue;
-            }
-            if (real_r2 < in_r2 ) {
-                edge_alpha = sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, color, sgl_sqrt_error(real_r2)) : sgl_color_mixer(sgl_color_mixer(border_color, color, edge_alpha), *blend, alpha));
-            }
-            else if (real_r2 > out_r2) {
-                edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(border_color, *blend, edge_alpha), *blend, alpha));
-            }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
-            }
-        }
+    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
+    for (int y = clip.y1; y <= clip.y2; y++) {
+        sgl_draw_mask_row(mask, radius, radius_in, y - cy, &row);
+        sgl_draw_mask_border_hline(buf, &clip, &row, cx, color, border_color, alpha);
         buf += surf->w;
     }
+
+    sgl_draw_mask_put(mask);
 }
 
 
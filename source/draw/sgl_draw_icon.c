@@ -28,6 +28,10 @@
 #include <sgl_math.h>
 
 
+/* the max number of pixels that are blended by one span */
+#define  SGL_ICON_SPAN_LEN         (64)
+
+
 /**
  * @brief draw icon with alpha
  * @param surf   surface
@@ -44,7 +48,7 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
     sgl_area_t clip = SGL_AREA_MAX;
     sgl_color_t *buf = NULL;
     int rel_x, rel_y, byte_x, dot_index;
-    uint8_t alpha_dot;
+    uint8_t alpha_dot, mask[SGL_ICON_SPAN_LEN];
 
     sgl_area_t icon_rect = {
         .x1 = x,
@@ -65,15 +69,21 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, y - surf->y1);
         rel_y = y - icon_rect.y1;
 
-        for (int x = clip.x1; x <= clip.x2; x++) {
-            rel_x = x - icon_rect.x1;
+        /* the dots of row are unpacked into coverage, and blended by span kernel */
+        for (int x = clip.x1; x <= clip.x2; x += SGL_ICON_SPAN_LEN) {
+            int len = sgl_min(clip.x2 - x + 1, SGL_ICON_SPAN_LEN);
+
+            for (int i = 0; i < len; i++) {
+                rel_x = x + i - icon_rect.x1;
+
+                byte_x = rel_x >> 1;
+                dot_index = byte_x + (rel_y * (icon->width >> 1));
+                alpha_dot = (rel_x & 1) ? dot[dot_index] & 0xF : (dot[dot_index] >> 4);
+                mask[i] = alpha_dot | (alpha_dot << 4);
+            }
 
-            byte_x = rel_x >> 1;
-            dot_index = byte_x + (rel_y * (icon->width >> 1));
-            alpha_dot = (rel_x & 1) ? dot[dot_index] & 0xF : (dot[dot_index] >> 4);
-            alpha_dot = alpha_dot | (alpha_dot << 4);
-            *buf = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *buf, alpha_dot) : sgl_color_mixer(sgl_color_mixer(color, *buf, alpha_dot), *buf, alpha));
-            buf++;
+            sgl_span_blend_mask(buf, color, mask, alpha, len);
+            buf += len;
         }
     }
 }
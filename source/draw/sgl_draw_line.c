@@ -40,7 +40,7 @@
  */
 void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t x1, int16_t x2, uint8_t width, sgl_color_t color, uint8_t alpha)
 {
-	sgl_color_t *buf = NULL, *blend = NULL;
+	sgl_color_t *buf = NULL;
 	sgl_area_t c_rect = {.x1 = x1, .x2 = x2, .y1 = y - (width - 1) / 2, .y2 = y + width / 2}, clip = SGL_AREA_MAX;
 
 	if (c_rect.x1 > c_rect.x2) {
@@ -54,10 +54,7 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
 
     buf = sgl_surf_get_buf(surf,  clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-		blend = buf;
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-        }
+        sgl_span_blend(buf, color, alpha, clip.x2 - clip.x1 + 1);
 		buf += surf->w;
     }
 }
@@ -76,7 +73,7 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
  */
 void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y1, int16_t y2, uint8_t width, sgl_color_t color, uint8_t alpha)
 {
-	sgl_color_t *buf = NULL, *blend = NULL;
+	sgl_color_t *buf = NULL;
 	sgl_area_t c_rect = {.x1 = x - (width - 1) / 2, .x2 = x + width / 2, .y1 = y1,.y2 = y2}, clip = SGL_AREA_MAX;
 
 	if (c_rect.y1 > c_rect.y2) {
@@ -90,32 +87,113 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t
 
     buf = sgl_surf_get_buf(surf,  clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-		blend = buf;
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-        }
+        sgl_span_blend(buf, color, alpha, clip.x2 - clip.x1 + 1);
         buf += surf->w;
     }
 }
 
 /**
- * SDF draw anti-aliased line
- * @param thickness line thickness (in pixels)
+ * @brief integer square root of a 64-bit number
+ * @param x number
+ * @return floor of the square root
  */
-static int32_t sgl_capsule_sdf_optimized(int16_t px, int16_t py, int16_t ax, int16_t ay, int16_t bx, int16_t by)
+static uint32_t line_sqrt64(uint64_t x)
 {
-	int64_t pax = px - ax, pay = py - ay, bax = bx - ax, bay = by - ay;
-	int64_t b_sqd = bax * bax + bay * bay;
-	int64_t h = (sgl_max(sgl_min((pax * bax + pay * bay), b_sqd), 0)) << 8;
-	int64_t dx = (pax << 8) - bax * h / b_sqd;
-	int64_t dy = (pay << 8) - bay * h / b_sqd;
+	uint64_t rem = 0, root = 0, divisor;
+
+	for (int i = 0; i < 32; i++) {
+		root <<= 1;
+		rem = (rem << 2) + (x >> 62);
+		x <<= 2;
+		divisor = (root << 1) + 1;
 
-	return sgl_sqrt(dx * dx + dy * dy);
+		if (divisor <= rem) {
+			rem -= divisor;
+			root++;
+		}
+	}
+	return (uint32_t)root;
 }
 
 
 /**
- * @brief draw a slanted line with alpha
+ * @brief floor division by a positive divisor
+ */
+static inline int64_t line_div_floor(int64_t n, int64_t d)
+{
+	return n >= 0 ? n / d : -((-n + d - 1) / d);
+}
+
+
+/* bound of a solved interval, far beyond any surface coordinate */
+#define LINE_SOLVE_LIMIT    (1 << 20)
+
+
+/**
+ * @brief solve lo <= a * x + b <= hi for the integer x interval
+ * @param a slope
+ * @param b offset
+ * @param lo lower bound
+ * @param hi upper bound
+ * @param x1 [in/out] interval start, only ever narrowed
+ * @param x2 [in/out] interval end, only ever narrowed
+ * @return none
+ */
+static void line_solve(int64_t a, int64_t b, int64_t lo, int64_t hi, int32_t *x1, int32_t *x2)
+{
+	int64_t t;
+
+	if (a == 0) {
+		if (b < lo || b > hi) {
+			*x2 = *x1 - 1;
+		}
+		return;
+	}
+	if (a < 0) {
+		a = -a; b = -b;
+		t = lo; lo = -hi; hi = -t;
+	}
+
+	t = -line_div_floor(b - lo, a);
+	if (t > *x1) {
+		*x1 = t > LINE_SOLVE_LIMIT ? LINE_SOLVE_LIMIT : (int32_t)t;
+	}
+	t = line_div_floor(hi - b, a);
+	if (t < *x2) {
+		*x2 = t < -LINE_SOLVE_LIMIT ? -LINE_SOLVE_LIMIT : (int32_t)t;
+	}
+}
+
+
+/**
+ * @brief blend one edge pixel of a line by its distance to the center line
+ * @param blend pixel
+ * @param d distance in 1/256 pixel
+ * @param inner distance below which the pixel is solid, in 1/256 pixel
+ * @param color line color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void line_blend_pixel(sgl_color_t *blend, int32_t d, int32_t inner, sgl_color_t color, uint8_t alpha)
+{
+	uint8_t c;
+
+	if (d <= inner) {
+		*blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
+	}
+	else if (d < inner + 256) {
+		c = d - inner;
+
+		if (alpha == SGL_ALPHA_MAX)
+			*blend = sgl_color_mixer(*blend, color, c);
+		else
+			*blend = sgl_color_mixer(sgl_color_mixer(*blend, color, c), *blend, alpha);
+	}
+}
+
+
+/**
+ * @brief draw a line of any direction with alpha
  * @param surf surface
  * @param area area that contains the line
  * @param x1 line start x position
@@ -123,19 +201,28 @@ static int32_t sgl_capsule_sdf_optimized(int16_t px, int16_t py, int16_t ax, int
  * @param x2 line end x position
  * @param y2 line end y position
  * @param thickness line width
+ * @param cap line cap, SGL_LINE_CAP_ROUND or SGL_LINE_CAP_FLAT
  * @param color line color
  * @param alpha alpha of color
  * @return none
- * @note This algorithm is SDF algorithm
+ * @note Each row only visits the pixels inside the stroke band. The band is cut
+ *       from the row by the two edge equations of the line and the two end
+ *       planes, the solid middle is drawn as one span and only the edge pixels
+ *       compute a coverage, from the perpendicular distance for the sides and
+ *       from the distance to the end point (round) or end plane (flat) for the caps.
  */
-void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha)
+void sgl_draw_fill_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, uint8_t cap, sgl_color_t color, uint8_t alpha)
 {
-	uint8_t c;
-	int64_t len;
 	sgl_area_t clip = SGL_AREA_MAX;
 	sgl_color_t *buf = NULL, *blend = NULL;
-	int16_t thick_half = (thickness >> 1);
-	sgl_area_t c_rect = {.x1 = x1 - thick_half, .x2 = x2 + thick_half, .y1 = y1 - thick_half,.y2 = y2 + thick_half};
+	int32_t thick_half = (thickness >> 1), inner, d, s, ox1, ox2, ix1, ix2;
+	int64_t bax = x2 - x1, bay = y2 - y1, len2 = bax * bax + bay * bay;
+	int64_t len, inv, reach, px, py, dot, cross, m, r2;
+	sgl_area_t c_rect = {.x1 = x1, .x2 = x2, .y1 = y1, .y2 = y2};
+
+	if (thick_half <= 0 || (len2 == 0 && cap == SGL_LINE_CAP_FLAT)) {
+		return;
+	}
 
 	if (c_rect.x1 > c_rect.x2) {
 		sgl_swap(&c_rect.x1, &c_rect.x2);
@@ -143,38 +230,114 @@ void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int1
 	if (c_rect.y1 > c_rect.y2) {
 		sgl_swap(&c_rect.y1, &c_rect.y2);
 	}
+	c_rect.x1 -= thick_half; c_rect.x2 += thick_half;
+	c_rect.y1 -= thick_half; c_rect.y2 += thick_half;
 
 	sgl_surf_clip_area_return(surf, area, &clip);
 	if (!sgl_area_selfclip(&clip, &c_rect)) {
 		return;
 	}
 
+	/* length in 1/256 pixel and its reciprocal, so that |cross| * inv >> 24 is
+	 * the distance to the center line in 1/256 pixel */
+	len = len2 ? line_sqrt64((uint64_t)len2 << 16) : 1;
+	inv = ((int64_t)1 << 40) / len;
+	inner = (thick_half - 1) << 8;
+	reach = cap == SGL_LINE_CAP_ROUND ? (thick_half + 1) * len : len;
+
 	buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-	for (int y = clip.y1; y <= clip.y2; y++) {
-		blend = buf;
+	for (int y = clip.y1; y <= clip.y2; y++, buf += surf->w) {
+		py = y - y1;
 
-		for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-			len = sgl_capsule_sdf_optimized(x, y, x1, y1, x2, y2);
+		/* outer band: the sides pushed out by one pixel and the ends by the cap reach */
+		ox1 = clip.x1 - x1;
+		ox2 = clip.x2 - x1;
+		if (len2) {
+			line_solve(bay * 256, -py * bax * 256, -(thick_half + 1) * len, (thick_half + 1) * len, &ox1, &ox2);
+			line_solve(bax * 256, py * bay * 256, -reach, len2 * 256 + reach, &ox1, &ox2);
+		}
+		else {
+			line_solve(1, 0, -thick_half - 1, thick_half + 1, &ox1, &ox2);
+		}
+		if (ox1 > ox2) {
+			continue;
+		}
 
-			if (len <= (thick_half - 1) << 8) {
-				*blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
+		/* solid band: every pixel is within the inner radius of the center line */
+		ix1 = ox1;
+		ix2 = ox2;
+		if (len2 && inner > 0) {
+			line_solve(bay * 256, -py * bax * 256, -(thick_half - 1) * len, (thick_half - 1) * len, &ix1, &ix2);
+			if (cap == SGL_LINE_CAP_ROUND)
+				line_solve(bax, py * bay, 0, len2, &ix1, &ix2);
+			else
+				line_solve(bax * 256, py * bay * 256, len, len2 * 256 - len, &ix1, &ix2);
+		}
+		else {
+			ix1 = ox2 + 1;
+			ix2 = ox2;
+		}
+
+		blend = buf + (ox1 + x1 - clip.x1);
+		px = ox1;
+		dot = px * bax + py * bay;
+		cross = px * bay - py * bax;
+		for (; px <= ox2; px++, blend++, dot += bax, cross += bay) {
+			if (px == ix1 && ix1 <= ix2) {
+				sgl_span_blend(blend, color, alpha, ix2 - ix1 + 1);
+				blend += ix2 - px;
+				dot += (ix2 - px) * bax;
+				cross += (ix2 - px) * bay;
+				px = ix2;
 				continue;
 			}
 
-			if (len > ((thick_half - 1) << 8) && len < (thick_half << 8)) {
-				c = len - ((thick_half - 1) << 8);
+			/* round cap measures from the nearest end point beyond the end planes */
+			if (cap == SGL_LINE_CAP_ROUND && (len2 == 0 || dot < 0 || dot > len2)) {
+				r2 = dot < 0 ? px * px + py * py : (px - bax) * (px - bax) + (py - bay) * (py - bay);
+				if (r2 >= 0x10000) {
+					continue;
+				}
+				d = sgl_sqrt((uint32_t)r2 << 16);
+			}
+			else {
+				d = (int32_t)(((cross < 0 ? -cross : cross) * inv) >> 24);
+			}
 
-				if (alpha == SGL_ALPHA_MAX)
-					*blend = sgl_color_mixer(*blend, color, c);
-				else
-					*blend = sgl_color_mixer(sgl_color_mixer(*blend, color, c), *blend, alpha);
+			/* flat cap ramps across the end plane, from half a pixel inside to half outside */
+			m = dot < len2 - dot ? dot : len2 - dot;
+			if (cap == SGL_LINE_CAP_FLAT && m * 256 < len) {
+				s = (int32_t)(((m < 0 ? -m : m) * inv) >> 24);
+				s = inner + 128 + (m < 0 ? s : -s);
+				d = d > s ? d : s;
 			}
+
+			line_blend_pixel(blend, d, inner, color, alpha);
 		}
-		buf += surf->w;
 	}
 }
 
 
+/**
+ * @brief draw a slanted line with alpha
+ * @param surf surface
+ * @param area area that contains the line
+ * @param x1 line start x position
+ * @param y1 line start y position
+ * @param x2 line end x position
+ * @param y2 line end y position
+ * @param thickness line width
+ * @param color line color
+ * @param alpha alpha of color
+ * @return none
+ * @note This draws a line with round caps, see sgl_draw_fill_line
+ */
+void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha)
+{
+	sgl_draw_fill_line(surf, area, x1, y1, x2, y2, thickness, SGL_LINE_CAP_ROUND, color, alpha);
+}
+
+
 /**
  * @brief draw a line
  * @param surf surface
@@ -198,6 +361,6 @@ void sgl_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *coords, sgl_d
 		sgl_draw_fill_hline(surf, area, y1, x1, x2, desc->width / 2, desc->color, alpha);
 	}
 	else {
-		draw_line_fill_slanted(surf, area, x1, y1, x2, y2, desc->width, desc->color, alpha);
+		sgl_draw_fill_line(surf, area, x1, y1, x2, y2, desc->width, desc->cap, desc->color, alpha);
 	}
 }
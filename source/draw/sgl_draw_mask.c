@@ -0,0 +1,531 @@
+/* source/draw/sgl_draw_mask.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * A row of circle or ring is split into hole, inner edge, solid and outer edge by four half widths,
+ * only the pixels of edges are anti-aliasing. The widgets use a few radiuses over and over, so the
+ * half widths and the coverage of edges of a quarter are kept in a LRU cache, the other quarters
+ * are got by symmetry. The masks are carved from a fixed pool of CONFIG_SGL_DRAW_MASK_CACHE bytes
+ * that is split among the render bands, so the draw path neither allocates nor locks. The shapes
+ * that are not cached are computed row by row in the same way. A bordered circle or corner is a ring
+ * whose inner radius is the inner side of border, its hole is the fill.
+ */
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_list.h>
+#include <sgl_log.h>
+#include <sgl_mm.h>
+
+
+/**
+ * @node:      node of LRU list
+ * @row:       rows from center to outer radius, the coverage follows rows
+ * @size:      bytes of mask in pool
+ * @radius:    outer radius
+ * @radius_in: inner radius of ring, -1 for circle
+ * @ref:       number of users, the mask is not evicted while it is used
+ */
+struct sgl_draw_mask {
+    sgl_list_node_t       node;
+    sgl_draw_mask_row_t   *row;
+    size_t                size;
+    int16_t               radius;
+    int16_t               radius_in;
+    uint16_t              ref;
+};
+
+
+/**
+ * @brief get the half widths of a row
+ * @param radius outer radius
+ * @param radius_in inner radius of ring, -1 for circle
+ * @param y2 square of the distance from row to center
+ * @param half output half widths
+ * @return none
+ * @note the thresholds are same as the per-pixel tests of circle and ring, and the circle is solid
+ *       inside the radius while the ring is solid on the radius
+ */
+static void sgl_draw_mask_half(int16_t radius, int16_t radius_in, int y2, int16_t half[4])
+{
+    int r2[4], h = 0;
+
+    if (radius_in < 0) {
+        r2[0] = 0;
+        r2[1] = 0;
+        r2[2] = sgl_pow2(radius);
+    }
+    else {
+        r2[0] = sgl_pow2(radius_in - 1);
+        r2[1] = sgl_max(sgl_pow2(radius_in), r2[0]);
+        r2[2] = sgl_pow2(radius) + 1;
+    }
+    r2[3] = sgl_pow2(radius + 1);
+
+    half[0] = sgl_draw_circle_half(r2[0], y2);
+    for (int i = 1; i < 4; i++) {
+        h = sgl_draw_circle_half(r2[i], y2);
+        half[i] = sgl_max(h, half[i - 1]);
+    }
+}
+
+
+/**
+ * @brief compute the coverage of an edge pixel
+ * @param part 1 for inner edge, 3 for outer edge
+ * @param real_r2 square of the distance from pixel to center
+ * @return coverage of pixel
+ */
+static inline uint8_t sgl_draw_mask_coverage(int part, int real_r2)
+{
+    return part == 1 ? sgl_sqrt_error(real_r2) : SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+}
+
+
+#if (CONFIG_SGL_DRAW_MASK_CACHE)
+
+/* every render band has its own pool, so the bands never wait for each other */
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+#define  SGL_DRAW_MASK_POOL_NUM      (CONFIG_SGL_RENDER_THREADS)
+#define  sgl_draw_mask_pool_of(surf) (&sgl_draw_mask_pool[(surf)->band])
+#else
+#define  SGL_DRAW_MASK_POOL_NUM      (1)
+#define  sgl_draw_mask_pool_of(surf) (&sgl_draw_mask_pool[0])
+#endif
+#define  SGL_DRAW_MASK_POOL_WORDS    (CONFIG_SGL_DRAW_MASK_CACHE / SGL_DRAW_MASK_POOL_NUM / sizeof(size_t))
+
+
+/**
+ * @mem:  the masks are carved from here in turn, the oldest masks are overwritten when it wraps
+ * @head: offset in bytes where next mask is carved
+ * @lru:  the masks in pool, the recently used mask is at front
+ */
+static struct sgl_draw_mask_pool {
+    size_t                mem[SGL_DRAW_MASK_POOL_WORDS];
+    size_t                head;
+    sgl_list_node_t       lru;
+} sgl_draw_mask_pool[SGL_DRAW_MASK_POOL_NUM];
+
+
+/**
+ * @brief carve the memory of a mask from pool, the masks that overlap it are evicted
+ * @param pool pool of band
+ * @param size bytes of mask
+ * @return memory of mask, NULL if it is larger than pool or it overlaps a mask in use
+ */
+static sgl_draw_mask_t* sgl_draw_mask_carve(struct sgl_draw_mask_pool *pool, size_t size)
+{
+    sgl_list_node_t *node = NULL, *next = NULL;
+    sgl_draw_mask_t *mask = NULL;
+    uint8_t *start = NULL, *end = NULL;
+
+    size = SGL_ALIGN_UP(size, sizeof(size_t));
+    if (size > sizeof(pool->mem)) {
+        return NULL;
+    }
+
+    if (pool->head + size > sizeof(pool->mem)) {
+        pool->head = 0;
+    }
+
+    start = (uint8_t*)pool->mem + pool->head;
+    end = start + size;
+
+    /* the masks in the way must not be used by the shape that is being drawn */
+    sgl_list_for_each(node, &pool->lru) {
+        mask = sgl_container_of(node, sgl_draw_mask_t, node);
+        if ((uint8_t*)mask < end && (uint8_t*)mask + mask->size > start && mask->ref != 0) {
+            return NULL;
+        }
+    }
+
+    for (node = pool->lru.next; node != &pool->lru; node = next) {
+        next = node->next;
+        mask = sgl_container_of(node, sgl_draw_mask_t, node);
+        if ((uint8_t*)mask < end && (uint8_t*)mask + mask->size > start) {
+            sgl_list_del_node(&mask->node);
+        }
+    }
+
+    pool->head += size;
+    mask = (sgl_draw_mask_t*)start;
+    mask->size = size;
+    return mask;
+}
+
+
+/**
+ * @brief build the mask of a circle or ring
+ * @param pool pool of band
+ * @param radius outer radius
+ * @param radius_in inner radius of ring, -1 for circle
+ * @return mask, NULL if it is larger than pool
+ */
+static sgl_draw_mask_t* sgl_draw_mask_build(struct sgl_draw_mask_pool *pool, int16_t radius, int16_t radius_in)
+{
+    sgl_draw_mask_t *mask = NULL;
+    sgl_draw_mask_row_t *row = NULL;
+    int16_t half[4];
+    uint8_t *cov = NULL;
+    size_t num = 0, size = 0;
+
+    /* the half widths are computed twice, the first pass only counts the edge pixels */
+    for (int dy = 0; dy <= radius; dy++) {
+        sgl_draw_mask_half(radius, radius_in, sgl_pow2(dy), half);
+        num += (half[1] - half[0]) + (half[3] - half[2]);
+    }
+
+    size = sizeof(sgl_draw_mask_t) + (radius + 1) * sizeof(sgl_draw_mask_row_t) + num;
+    mask = sgl_draw_mask_carve(pool, size);
+    if (mask == NULL) {
+        return NULL;
+    }
+
+    mask->row = (sgl_draw_mask_row_t*)(mask + 1);
+    mask->radius = radius;
+    mask->radius_in = radius_in;
+    mask->ref = 0;
+    cov = (uint8_t*)(mask->row + radius + 1);
+
+    for (int dy = 0; dy <= radius; dy++) {
+        row = &mask->row[dy];
+        row->y2 = sgl_pow2(dy);
+        row->cov = cov;
+        sgl_draw_mask_half(radius, radius_in, row->y2, row->half);
+
+        for (int part = 1; part <= 3; part += 2) {
+            for (int d = row->half[part - 1] + 1; d <= row->half[part]; d++) {
+                *cov++ = sgl_draw_mask_coverage(part, sgl_pow2(d) + row->y2);
+            }
+        }
+    }
+
+    return mask;
+}
+
+
+/**
+ * @brief get the cached coverage mask of a circle or ring, the mask is built if it is not cached
+ * @param surf surface that the shape is drawn to, the mask is kept in the pool of its band
+ * @param radius outer radius
+ * @param radius_in inner radius of ring, -1 for circle
+ * @return mask, NULL if the cache is disabled or the mask is larger than pool
+ * @note the mask is kept until sgl_draw_mask_put is called, the rows of NULL mask are computed
+ *       by sgl_draw_mask_row directly, so the caller does not need to check it
+ */
+const sgl_draw_mask_t* sgl_draw_mask_get(sgl_surf_t *surf, int16_t radius, int16_t radius_in)
+{
+    struct sgl_draw_mask_pool *pool = sgl_draw_mask_pool_of(surf);
+    sgl_list_node_t *node = NULL;
+    sgl_draw_mask_t *mask = NULL;
+
+    SGL_UNUSED(surf);
+
+    if (radius < 0) {
+        return NULL;
+    }
+
+    radius_in = sgl_max(radius_in, -1);
+
+    /* the pool is zero before first use */
+    if (pool->lru.next == NULL) {
+        sgl_list_init(&pool->lru);
+    }
+
+    sgl_list_for_each(node, &pool->lru) {
+        mask = sgl_container_of(node, sgl_draw_mask_t, node);
+        if (mask->radius == radius && mask->radius_in == radius_in) {
+            sgl_list_del_node(&mask->node);
+            break;
+        }
+        mask = NULL;
+    }
+
+    if (mask == NULL) {
+        mask = sgl_draw_mask_build(pool, radius, radius_in);
+    }
+
+    if (mask != NULL) {
+        sgl_list_add_node_at_front(&pool->lru, &mask->node);
+        mask->ref++;
+    }
+
+    return mask;
+}
+
+
+/**
+ * @brief give back the mask that is got by sgl_draw_mask_get, then it can be evicted
+ * @param mask mask, it can be NULL
+ * @return none
+ */
+void sgl_draw_mask_put(const sgl_draw_mask_t *mask)
+{
+    if (mask == NULL) {
+        return;
+    }
+
+    ((sgl_draw_mask_t*)mask)->ref--;
+}
+
+
+/**
+ * @brief free all cached masks that are not used
+ * @param none
+ * @return none
+ * @note it must not be called while the bands are drawn
+ */
+void sgl_draw_mask_clear(void)
+{
+    struct sgl_draw_mask_pool *pool = NULL;
+    sgl_list_node_t *node = NULL, *next = NULL;
+    sgl_draw_mask_t *mask = NULL;
+
+    for (int i = 0; i < SGL_DRAW_MASK_POOL_NUM; i++) {
+        pool = &sgl_draw_mask_pool[i];
+        if (pool->lru.next == NULL) {
+            continue;
+        }
+
+        for (node = pool->lru.next; node != &pool->lru; node = next) {
+            next = node->next;
+            mask = sgl_container_of(node, sgl_draw_mask_t, node);
+            if (mask->ref == 0) {
+                sgl_list_del_node(&mask->node);
+            }
+        }
+
+        if (sgl_list_is_empty(&pool->lru)) {
+            pool->head = 0;
+        }
+    }
+}
+
+#else
+
+const sgl_draw_mask_t* sgl_draw_mask_get(sgl_surf_t *surf, int16_t radius, int16_t radius_in)
+{
+    SGL_UNUSED(surf);
+    SGL_UNUSED(radius);
+    SGL_UNUSED(radius_in);
+    return NULL;
+}
+
+
+void sgl_draw_mask_put(const sgl_draw_mask_t *mask)
+{
+    SGL_UNUSED(mask);
+}
+
+
+void sgl_draw_mask_clear(void)
+{
+}
+
+#endif // !CONFIG_SGL_DRAW_MASK_CACHE
+
+
+/**
+ * @brief get a row of circle or ring
+ * @param mask cached mask, NULL to compute the row
+ * @param radius outer radius
+ * @param radius_in inner radius of ring, -1 for circle
+ * @param dy distance from row to center
+ * @param row output row
+ * @return none
+ */
+void sgl_draw_mask_row(const sgl_draw_mask_t *mask, int16_t radius, int16_t radius_in, int dy, sgl_draw_mask_row_t *row)
+{
+    dy = sgl_abs(dy);
+
+    if (mask != NULL && dy <= mask->radius) {
+        *row = mask->row[dy];
+        return;
+    }
+
+    row->y2 = sgl_pow2(dy);
+    row->cov = NULL;
+    sgl_draw_mask_half(radius, sgl_max(radius_in, -1), row->y2, row->half);
+}
+
+
+/**
+ * @brief blend the anti-aliasing pixels of an edge part of row on one side of center
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of circle or ring
+ * @param part 1 for inner edge, 3 for outer edge
+ * @param cx x of center
+ * @param dir -1 for the pixels at left of center, 1 for right
+ * @param d1 min distance from pixel to center, the pixels nearer than the edge are skipped
+ * @param d2 max distance from pixel to center, the pixels farther than the edge are skipped
+ * @param color color of shape
+ * @param under color that the edge is mixed over, NULL to mix over the pixels of buffer
+ * @param alpha alpha of shape
+ * @return none
+ */
+static void sgl_draw_mask_blend(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int part, int cx, int dir, int d1, int d2, sgl_color_t color, const sgl_color_t *under, uint8_t alpha)
+{
+    const uint8_t *cov = NULL;
+    sgl_color_t *blend = NULL;
+    sgl_color_t mix;
+    int start = row->half[part - 1] + 1;
+    int x1, x2, d;
+    uint8_t cover;
+
+    d1 = sgl_max(d1, start);
+    d2 = sgl_min(d2, row->half[part]);
+    x1 = sgl_max(dir > 0 ? cx + d1 : cx - d2, clip->x1);
+    x2 = sgl_min(dir > 0 ? cx + d2 : cx - d1, clip->x2);
+
+    /* the coverage of edge is indexed by the distance to center */
+    if (row->cov != NULL) {
+        cov = row->cov + (part == 3 ? row->half[1] - row->half[0] : 0);
+    }
+
+    /* the edges are a few pixels, so they are blended here instead of span kernel */
+    blend = buf + (x1 - clip->x1);
+    for (int x = x1; x <= x2; x++, blend++) {
+        d = sgl_abs(x - cx);
+        cover = (cov != NULL ? cov[d - start] : sgl_draw_mask_coverage(part, sgl_pow2(d) + row->y2));
+        mix = sgl_color_mixer(color, under != NULL ? *under : *blend, cover);
+        *blend = (alpha == SGL_ALPHA_MAX ? mix : sgl_color_mixer(mix, *blend, alpha));
+    }
+}
+
+
+/**
+ * @brief blend the anti-aliasing pixels of an edge part of row on one side of center
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of circle or ring
+ * @param part 1 for inner edge, 3 for outer edge
+ * @param cx x of center
+ * @param dir -1 for the pixels at left of center, 1 for right
+ * @param d1 min distance from pixel to center, the pixels nearer than the edge are skipped
+ * @param d2 max distance from pixel to center, the pixels farther than the edge are skipped
+ * @param color color of shape
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_edge(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int part, int cx, int dir, int d1, int d2, sgl_color_t color, uint8_t alpha)
+{
+    sgl_draw_mask_blend(buf, clip, row, part, cx, dir, d1, d2, color, NULL, alpha);
+}
+
+
+/**
+ * @brief draw a full row of circle or ring, the solid part is drawn as span and the edges by mask
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of circle or ring
+ * @param cx x of center
+ * @param color color of shape
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_hline(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int cx, sgl_color_t color, uint8_t alpha)
+{
+    int lo = 0, hi = 0;
+
+    for (int part = 1; part <= 3; part++) {
+        lo = row->half[part - 1];
+        hi = row->half[part];
+
+        if (hi <= lo) {
+            continue;
+        }
+
+        if (part != 2) {
+            /* the center pixel is on the left side */
+            sgl_draw_mask_edge(buf, clip, row, part, cx, -1, 0, hi, color, alpha);
+            sgl_draw_mask_edge(buf, clip, row, part, cx, 1, 1, hi, color, alpha);
+        }
+        else if (lo < 0) {
+            sgl_draw_hspan(buf, clip, cx - hi, cx + hi, color, alpha);
+        }
+        else {
+            sgl_draw_hspan(buf, clip, cx - hi, cx - lo - 1, color, alpha);
+            sgl_draw_hspan(buf, clip, cx + lo + 1, cx + hi, color, alpha);
+        }
+    }
+}
+
+
+/**
+ * @brief draw the pixels of a bordered row on one side of center, the hole of ring is the fill, the
+ *        inner edge mixes the border into the fill, the solid part is the border and the outer edge
+ *        mixes the border into the buffer
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of ring whose inner radius is the inner side of border
+ * @param cx x of center
+ * @param dir -1 for the pixels at left of center, 1 for right
+ * @param d1 min distance from pixel to center, the nearer pixels are skipped
+ * @param color color of fill
+ * @param border_color color of border
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_border_side(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int cx, int dir, int d1, sgl_color_t color, sgl_color_t border_color, uint8_t alpha)
+{
+    int lo = 0, hi = 0;
+
+    for (int part = 0; part <= 3; part++) {
+        lo = sgl_max(part > 0 ? row->half[part - 1] : -1, d1 - 1);
+        hi = row->half[part];
+
+        if (hi <= lo) {
+            continue;
+        }
+
+        if (part == 0 || part == 2) {
+            sgl_draw_hspan(buf, clip, dir > 0 ? cx + lo + 1 : cx - hi, dir > 0 ? cx + hi : cx - lo - 1, part == 0 ? color : border_color, alpha);
+        }
+        else {
+            sgl_draw_mask_blend(buf, clip, row, part, cx, dir, d1, hi, border_color, part == 1 ? &color : NULL, alpha);
+        }
+    }
+}
+
+
+/**
+ * @brief draw a full bordered row of circle, the fill and the border are drawn as spans and the
+ *        edges by mask
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of ring whose inner radius is the inner side of border
+ * @param cx x of center
+ * @param color color of fill
+ * @param border_color color of border
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_border_hline(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int cx, sgl_color_t color, sgl_color_t border_color, uint8_t alpha)
+{
+    /* the fill crosses the center as one span, the center pixel of other parts is on the left side */
+    sgl_draw_hspan(buf, clip, cx - row->half[0], cx + row->half[0], color, alpha);
+    sgl_draw_mask_border_side(buf, clip, row, cx, -1, row->half[0] + 1, color, border_color, alpha);
+    sgl_draw_mask_border_side(buf, clip, row, cx, 1, sgl_max(row->half[0] + 1, 1), color, border_color, alpha);
+}
@@ -37,18 +37,21 @@
  * @param color color of rectangle
  * @param alpha alpha of rectangle
  * @return none
+ * @note the corner rows are split into edges and one solid span by the half widths of corner, the
+ *       corners of same radius share the cached mask
  */
 void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, int16_t radius, sgl_color_t color, uint8_t alpha)
 {
     sgl_area_t clip;
-    sgl_color_t *buf = NULL, *blend = NULL;
-    uint8_t edge_alpha = 0;
+    sgl_color_t *buf = NULL;
     int cx1 = rect->x1 + radius;
     int cx2 = rect->x2 - radius;
     int cy1 = rect->y1 + radius;
     int cy2 = rect->y2 - radius;
-    int cx_tmp = 0;
     int cy_tmp = 0;
+    int inner = 0;
+    const sgl_draw_mask_t *mask = NULL;
+    sgl_draw_mask_row_t row;
 
     if (!sgl_surf_clip(surf, area, &clip)) {
         return;
@@ -58,54 +61,69 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
         return;
     }
 
-    int y2 = 0, real_r2 = 0;
-    int r2 = sgl_pow2(radius);
-    int r2_edge = sgl_pow2(radius + 1);
-
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     if (radius == 0) {
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-            }
+            sgl_span_blend(buf, color, alpha, clip.x2 - clip.x1 + 1);
             buf += surf->w;
         }
     }
     else {
+        mask = sgl_draw_mask_get(surf, radius, -1);
+
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
             if (y > cy1 && y < cy2) {
-                for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                    *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                }
+                sgl_span_blend(buf, color, alpha, clip.x2 - clip.x1 + 1);
             }
             else {
+                /* the corners of row are two circle rows, the straight part is between them */
                 cy_tmp = y > cy1 ? cy2 : cy1;
-                y2 = sgl_pow2(y - cy_tmp);
+                sgl_draw_mask_row(mask, radius, -1, y - cy_tmp, &row);
+                inner = row.half[2];
 
-                for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                    if (x > cx1 && x < cx2) {
-                        *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                    }
-                    else {
-                        cx_tmp = x > cx1 ? cx2 : cx1;
-                        real_r2 = sgl_pow2(x - cx_tmp) + y2;
-                        if (real_r2 >= r2_edge) {
-                            continue;
-                        }
-                        else if (real_r2 >= r2) {
-                            edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                            *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
-                        }
-                        else {
-                            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                        }
-                    }
+                sgl_draw_mask_edge(buf, &clip, &row, 3, cx1, -1, 0, row.half[3], color, alpha);
+                if (inner >= 0) {
+                    sgl_draw_hspan(buf, &clip, cx1 - inner, sgl_max(cx2 + inner, cx1), color, alpha);
+                }
+                else {
+                    sgl_draw_hspan(buf, &clip, cx1 + 1, cx2 - 1, color, alpha);
                 }
+                sgl_draw_mask_edge(buf, &clip, &row, 3, cx2, 1, cx1 + 1 - cx2, row.half[3], color, alpha);
             }
             buf += surf->w;
         }
+
+        sgl_draw_mask_put(mask);
+    }
+}
+
+
+/**
+ * @brief blend a row of rectangle, the pixels between x1 and x2 are color, the others are border color
+ * @param buf point to the first pixel of clip in row
+ * @param clip clip area of row
+ * @param x1 first x of inner part
+ * @param x2 last x of inner part
+ * @param color color of inner part
+ * @param border_color color of border
+ * @param alpha alpha of rectangle
+ * @return none
+ */
+static inline void sgl_draw_rect_border_row(sgl_color_t *buf, sgl_area_t *clip, int x1, int x2, sgl_color_t color, sgl_color_t border_color, uint8_t alpha)
+{
+    int left = sgl_min(x1 - 1, clip->x2);
+    int right = sgl_max(sgl_max(x2 + 1, left + 1), clip->x1);
+    int in1 = sgl_max(x1, clip->x1);
+    int in2 = sgl_min(x2, clip->x2);
+
+    if (left >= clip->x1) {
+        sgl_span_blend(buf, border_color, alpha, left - clip->x1 + 1);
+    }
+    if (in1 <= in2) {
+        sgl_span_blend(buf + (in1 - clip->x1), color, alpha, in2 - in1 + 1);
+    }
+    if (right <= clip->x2) {
+        sgl_span_blend(buf + (right - clip->x1), border_color, alpha, clip->x2 - right + 1);
     }
 }
 
@@ -122,15 +140,16 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
  * @param border_width width of border
  * @param alpha alpha of rectangle
  * @return none
+ * @note the corners are rows of a ring whose inner radius is the inner side of border, so a corner
+ *       row is the fill, the inner edge, the border and the outer edge as spans and edges, the
+ *       corners of same radius and border share the cached mask
  */
 void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, int16_t radius, sgl_color_t color, sgl_color_t border_color, uint8_t border_width, uint8_t alpha)
 {
     int radius_in = sgl_max(radius - border_width + 1, 0);
-    int y2 = 0, real_r2 = 0;
-    int in_r2 = sgl_pow2(radius_in);
-    int out_r2 = sgl_pow2(radius);
-    sgl_color_t *buf = NULL, *blend = NULL;
-    uint8_t edge_alpha = 0;
+    sgl_color_t *buf = NULL;
+    const sgl_draw_mask_t *mask = NULL;
+    sgl_draw_mask_row_t row;
 
     int cx1 = rect->x1 + radius;
     int cx2 = rect->x2 - radius;
@@ -140,12 +159,8 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
     int cx2i = rect->x2 - border_width;
     int cyi1 = rect->y1 + border_width;
     int cyi2 = rect->y2 - border_width;
-    int cx_tmp = 0;
     int cy_tmp = 0;
 
-    int in_r2_max = sgl_pow2(radius_in - 1);
-    int out_r2_max = sgl_pow2(radius + 1);
-
     sgl_area_t clip;
 
     if (!sgl_surf_clip(surf, area, &clip)) {
@@ -159,71 +174,35 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     if (radius == 0) {
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                if (x >= cx1i && x <= cx2i && y >= cyi1 && y <= cyi2) {
-                    *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-                }
-                else {
-                    *blend = alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha);
-                }
+            if (y >= cyi1 && y <= cyi2) {
+                sgl_draw_rect_border_row(buf, &clip, cx1i, cx2i, color, border_color, alpha);
+            }
+            else {
+                sgl_span_blend(buf, border_color, alpha, clip.x2 - clip.x1 + 1);
             }
             buf += surf->w;
         }
     }
     else {
+        mask = sgl_draw_mask_get(surf, radius, radius_in);
+
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
             if (y > cy1 && y < cy2) {
-                for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                    if (x < cx1i || x > cx2i) {
-                        *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
-                    }
-                    else {
-                        *blend = (alpha == SGL_ALPHA_MAX ? color: sgl_color_mixer(color, *blend, alpha));
-                    }
-                }
+                sgl_draw_rect_border_row(buf, &clip, cx1i, cx2i, color, border_color, alpha);
             }
             else {
                 cy_tmp = y > cy1 ? cy2 : cy1;
-                y2 = sgl_pow2(y - cy_tmp);
+                sgl_draw_mask_row(mask, radius, radius_in, y - cy_tmp, &row);
 
-                for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                    if (x >= cx1 && x <= cx2) {
-                        if (y < cyi1 || y > cyi2) {
-                            *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
-                        }
-                        else {
-                            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                        }
-                    }
-                    else {
-                        cx_tmp = x > cx1 ? cx2 : cx1;
-                        real_r2 = sgl_pow2(x - cx_tmp) + y2;
-
-                        if (real_r2 >= out_r2_max) {
-                            continue;
-                        }
-                        if (real_r2 < in_r2_max) {
-                            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                            continue;
-                        }
-                        if (real_r2 < in_r2 ) {
-                            edge_alpha = sgl_sqrt_error(real_r2);
-                            *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, color, edge_alpha) : sgl_color_mixer(sgl_color_mixer(border_color, color, edge_alpha), *blend, alpha));
-                        }
-                        else if (real_r2 > out_r2) {
-                            edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                            *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(border_color, *blend, edge_alpha), *blend, alpha));
-                        }
-                        else {
-                            *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
-                        }
-                    }
-                }
+                /* the straight part between corners, the corners start next to it */
+                sgl_draw_hspan(buf, &clip, cx1, cx2, (y < cyi1 || y > cyi2) ? border_color : color, alpha);
+                sgl_draw_mask_border_side(buf, &clip, &row, cx1, -1, cx1 <= cx2 ? 1 : 0, color, border_color, alpha);
+                sgl_draw_mask_border_side(buf, &clip, &row, cx2, 1, sgl_max(cx1 + 1 - cx2, 1), color, border_color, alpha);
             }
             buf += surf->w;
         }
+
+        sgl_draw_mask_put(mask);
     }
 }
 
@@ -272,6 +251,12 @@ void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *r
         for (int y = clip.y1; y <= clip.y2; y++) {
             blend = buf;
             step_y = (scale_y * (y - rect->y1)) >> SGL_FIXED_SHIFT;
+            if (scale_x == SGL_FIXED_ONE) {
+                /* the row is not scaled, it is copied from pixmap as span */
+                sgl_span_copy(buf, sgl_pixmap_get_buf(pixmap, clip.x1 - rect->x1, step_y), alpha, clip.x2 - clip.x1 + 1);
+                buf += surf->w;
+                continue;
+            }
             for (int x = clip.x1; x <= clip.x2; x++, blend++) {
                 step_x = (scale_x * (x - rect->x1)) >> SGL_FIXED_SHIFT;
                 pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
@@ -284,7 +269,10 @@ void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *r
         for (int y = clip.y1; y <= clip.y2; y++) {
             blend = buf;
             step_y = (scale_y * (y - rect->y1)) >> SGL_FIXED_SHIFT;
-            if (y > cy1 && y < cy2) {
+            if (y > cy1 && y < cy2 && scale_x == SGL_FIXED_ONE) {
+                sgl_span_copy(buf, sgl_pixmap_get_buf(pixmap, clip.x1 - rect->x1, step_y), alpha, clip.x2 - clip.x1 + 1);
+            }
+            else if (y > cy1 && y < cy2) {
                 for (int x = clip.x1; x <= clip.x2; x++, blend++) {
                     step_x = (scale_x * (x - rect->x1)) >> SGL_FIXED_SHIFT;
                     pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
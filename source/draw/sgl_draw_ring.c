@@ -38,16 +38,15 @@
  * @param color: ring color
  * @param alpha: ring alpha
  * @return none
+ * @note every row is split into hole, inner edge, solid and outer edge by the half widths of
+ *       the radiuses, so only the pixels of edges are blended by coverage, the half widths and
+ *       coverage of same ring are got from mask cache
  */
 void sgl_draw_fill_ring(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius_in, int16_t radius_out, sgl_color_t color, uint8_t alpha)
 {
-    int y2 = 0, real_r2 = 0, edge_alpha = 0;
-    int in_r2 = sgl_pow2(radius_in);
-    int out_r2 = sgl_pow2(radius_out);
-    
-    int in_r2_max = sgl_pow2(radius_in - 1);
-    int out_r2_max = sgl_pow2(radius_out + 1);
-    sgl_color_t *buf = NULL, *blend = NULL;
+    const sgl_draw_mask_t *mask = NULL;
+    sgl_draw_mask_row_t row;
+    sgl_color_t *buf = NULL;
     sgl_area_t clip;
 
     if (unlikely(alpha == SGL_ALPHA_MIN)) {
@@ -58,53 +57,14 @@ void sgl_draw_fill_ring(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t
         return;
     }
 
+    mask = sgl_draw_mask_get(surf, radius_out, radius_in);
+
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
-        y2 = sgl_pow2(y - cy);
-        
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
-
-            if (real_r2 >= out_r2_max) {
-               if (x > cx) break;
-                continue;
-            }
-            if (real_r2 < in_r2_max) {
-                if (x < cx) {
-                    blend += ((cx - x) * 2);
-                    x = cx*2 - x;
-                }
-                continue;
-            }
-
-            if (alpha == SGL_ALPHA_MAX) {
-                if (real_r2 < in_r2 ) {
-                    *blend = sgl_color_mixer(color, *blend, sgl_sqrt_error(real_r2));
-                }
-                else if (real_r2 > out_r2) {
-                    *blend = sgl_color_mixer(color, *blend, SGL_ALPHA_MAX - sgl_sqrt_error(real_r2));
-                }
-                else {
-                    *blend = color;
-                }
-            }
-            else {
-                if (real_r2 < in_r2 ) {
-                    edge_alpha = sgl_sqrt_error(real_r2);
-                    sgl_color_t color_mix = sgl_color_mixer(color, *blend, edge_alpha);
-                    *blend = sgl_color_mixer(color_mix, *blend, alpha);
-                }
-                else if (real_r2 > out_r2) {
-                    edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                    sgl_color_t color_mix = sgl_color_mixer(color, *blend, edge_alpha);
-                    *blend = sgl_color_mixer(color_mix, *blend, alpha);
-                }
-                else {
-                    *blend = sgl_color_mixer(color, *blend, alpha);
-                }
-            }
-        }
+        sgl_draw_mask_row(mask, radius_out, radius_in, y - cy, &row);
+        sgl_draw_mask_hline(buf, &clip, &row, cx, color, alpha);
         buf += surf->w;
     }
+
+    sgl_draw_mask_put(mask);
 }
@@ -0,0 +1,458 @@
+/* source/draw/sgl_draw_span.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * The span kernels write one horizontal run of pixels. The primitives split their rows into runs
+ * of solid color, runs of coverage and runs of source pixels, so the per-pixel branches are out of
+ * the inner loops. The vector kernels are built with the vector extensions of GCC and clang when
+ * the target has SSE2, AVX2 or NEON, and give the same pixels as sgl_color_mixer bit by bit, the
+ * remainder of span and the other targets use the scalar loops.
+ */
+
+#include <string.h>
+#include <sgl_core.h>
+#include <sgl_draw.h>
+
+
+#if (CONFIG_SGL_DRAW_SIMD) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9)) \
+    && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define  SGL_SPAN_VECTOR                 (1)
+#else
+#define  SGL_SPAN_VECTOR                 (0)
+#endif
+
+
+#if (SGL_SPAN_VECTOR)
+
+#if defined(__AVX2__)
+#define  SGL_SPAN_VEC_BYTES              (32)
+#else
+#define  SGL_SPAN_VEC_BYTES              (16)
+#endif
+
+/* the pixels of 16 and 32 bit depth are processed in 32 bit lanes */
+#define  SGL_SPAN_LANES                  (SGL_SPAN_VEC_BYTES / 4)
+
+typedef uint32_t sgl_vu32_t   __attribute__((vector_size(SGL_SPAN_VEC_BYTES)));
+typedef uint16_t sgl_vpix16_t __attribute__((vector_size(SGL_SPAN_LANES * 2)));
+typedef uint8_t  sgl_vmask_t  __attribute__((vector_size(SGL_SPAN_LANES)));
+
+/* the pixels of 24 bit depth are processed byte by byte in 16 bit lanes */
+#define  SGL_SPAN_BYTES                  (SGL_SPAN_VEC_BYTES / 2)
+
+typedef uint16_t sgl_vu16_t   __attribute__((vector_size(SGL_SPAN_VEC_BYTES)));
+typedef uint8_t  sgl_vu8_t    __attribute__((vector_size(SGL_SPAN_BYTES)));
+
+#define  sgl_vec_load(v, p)              memcpy(&(v), (p), sizeof(v))
+#define  sgl_vec_store(p, v)             memcpy((p), &(v), sizeof(v))
+#define  sgl_vec_cast(v, type)           __builtin_convertvector(v, type)
+
+#endif // ! SGL_SPAN_VECTOR
+
+
+#if (SGL_SPAN_VECTOR) && (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+
+/**
+ * The RGB565 pixel is spread into 32 bits as 00000GGGGGG00000RRRRR000000BBBBB, so the three
+ * channels are mixed with one multiply, the same as sgl_color_mixer.
+ */
+static inline sgl_vu32_t sgl_vec_expand(sgl_vpix16_t pix)
+{
+    sgl_vu32_t v = sgl_vec_cast(pix, sgl_vu32_t);
+    return (v | (v << 16)) & 0x07E0F81F;
+}
+
+
+static inline sgl_vpix16_t sgl_vec_pack(sgl_vu32_t v)
+{
+    return sgl_vec_cast((v >> 16) | v, sgl_vpix16_t);
+}
+
+
+static inline sgl_vu32_t sgl_vec_mix(sgl_vu32_t fg, sgl_vu32_t bg, sgl_vu32_t factor)
+{
+    return ((((fg - bg) * factor) >> 5) + bg) & 0x07E0F81F;
+}
+
+
+static inline sgl_vu32_t sgl_vec_factor(sgl_vu32_t factor)
+{
+    return (factor + 4) >> 3;
+}
+
+
+static uint32_t sgl_span_fill_vec(sgl_color_t *dst, sgl_color_t color, uint32_t len)
+{
+    sgl_vpix16_t pix = (sgl_vpix16_t){0} + color.full;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_store(dst + i, pix);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_blend_vec(sgl_color_t *dst, sgl_color_t color, uint8_t alpha, uint32_t len)
+{
+    sgl_vu32_t fg = sgl_vec_expand((sgl_vpix16_t){0} + color.full);
+    sgl_vu32_t factor = sgl_vec_factor((sgl_vu32_t){0} + alpha);
+    sgl_vpix16_t pix;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_load(pix, dst + i);
+        pix = sgl_vec_pack(sgl_vec_mix(fg, sgl_vec_expand(pix), factor));
+        sgl_vec_store(dst + i, pix);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_blend_mask_vec(sgl_color_t *dst, sgl_color_t color, const uint8_t *mask, uint8_t alpha, uint32_t len)
+{
+    sgl_vu32_t fg = sgl_vec_expand((sgl_vpix16_t){0} + color.full);
+    sgl_vu32_t factor = sgl_vec_factor((sgl_vu32_t){0} + alpha), cover, bg;
+    sgl_vpix16_t pix;
+    sgl_vmask_t cov;
+    uint32_t i = 0;
+
+    /* the coverage 0 keeps background and SGL_ALPHA_MAX gives foreground, so there is no select */
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_load(pix, dst + i);
+        sgl_vec_load(cov, mask + i);
+        bg = sgl_vec_expand(pix);
+        cover = sgl_vec_mix(fg, bg, sgl_vec_factor(sgl_vec_cast(cov, sgl_vu32_t)));
+        if (alpha != SGL_ALPHA_MAX) {
+            cover = sgl_vec_mix(cover, bg, factor);
+        }
+        pix = sgl_vec_pack(cover);
+        sgl_vec_store(dst + i, pix);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_mix_vec(sgl_color_t *out, const sgl_color_t *fg, const sgl_color_t *bg, uint8_t factor, uint32_t len)
+{
+    sgl_vu32_t f = sgl_vec_factor((sgl_vu32_t){0} + factor);
+    sgl_vpix16_t a, b;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_load(a, fg + i);
+        sgl_vec_load(b, bg + i);
+        a = sgl_vec_pack(sgl_vec_mix(sgl_vec_expand(a), sgl_vec_expand(b), f));
+        sgl_vec_store(out + i, a);
+    }
+    return i;
+}
+
+#elif (SGL_SPAN_VECTOR) && (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_ARGB8888)
+
+/**
+ * bg + (fg - bg) * f / 256 of sgl_color_mixer is (fg * f + bg * (256 - f)) / 256 for every channel,
+ * the sums are not more than 16 bits, so two channels are mixed in one 32 bit lane.
+ */
+static inline sgl_vu32_t sgl_vec_mix(sgl_vu32_t fg, sgl_vu32_t bg, sgl_vu32_t factor)
+{
+    sgl_vu32_t inv = 256 - factor;
+    sgl_vu32_t rb = (((fg & 0x00FF00FF) * factor + (bg & 0x00FF00FF) * inv) >> 8) & 0x00FF00FF;
+    sgl_vu32_t ag = (((fg >> 8) & 0x00FF00FF) * factor + ((bg >> 8) & 0x00FF00FF) * inv) & 0xFF00FF00;
+    return rb | ag;
+}
+
+
+static uint32_t sgl_span_fill_vec(sgl_color_t *dst, sgl_color_t color, uint32_t len)
+{
+    sgl_vu32_t pix = (sgl_vu32_t){0} + color.full;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_store(dst + i, pix);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_blend_vec(sgl_color_t *dst, sgl_color_t color, uint8_t alpha, uint32_t len)
+{
+    sgl_vu32_t fg = (sgl_vu32_t){0} + color.full;
+    sgl_vu32_t factor = (sgl_vu32_t){0} + alpha;
+    sgl_vu32_t pix;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_load(pix, dst + i);
+        pix = sgl_vec_mix(fg, pix, factor);
+        sgl_vec_store(dst + i, pix);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_blend_mask_vec(sgl_color_t *dst, sgl_color_t color, const uint8_t *mask, uint8_t alpha, uint32_t len)
+{
+    sgl_vu32_t fg = (sgl_vu32_t){0} + color.full;
+    sgl_vu32_t factor = (sgl_vu32_t){0} + alpha, cover, pix, solid;
+    sgl_vmask_t cov;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_load(pix, dst + i);
+        sgl_vec_load(cov, mask + i);
+        cover = sgl_vec_cast(cov, sgl_vu32_t);
+        solid = (sgl_vu32_t)(cover == SGL_ALPHA_MAX);
+        cover = (fg & solid) | (sgl_vec_mix(fg, pix, cover) & ~solid);
+        if (alpha != SGL_ALPHA_MAX) {
+            cover = sgl_vec_mix(cover, pix, factor);
+        }
+        sgl_vec_store(dst + i, cover);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_mix_vec(sgl_color_t *out, const sgl_color_t *fg, const sgl_color_t *bg, uint8_t factor, uint32_t len)
+{
+    sgl_vu32_t f = (sgl_vu32_t){0} + factor;
+    sgl_vu32_t a, b;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_LANES <= len; i += SGL_SPAN_LANES) {
+        sgl_vec_load(a, fg + i);
+        sgl_vec_load(b, bg + i);
+        a = sgl_vec_mix(a, b, f);
+        sgl_vec_store(out + i, a);
+    }
+    return i;
+}
+
+#elif (SGL_SPAN_VECTOR) && (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB888)
+
+/* the solid color is repeated in a row of pixels that is a multiple of vector bytes */
+#define  SGL_SPAN_PATTERN_LEN            (SGL_SPAN_BYTES)
+
+
+/**
+ * mix every byte as (fg * f + bg * (256 - f)) / 256, it is the same as sgl_color_mixer
+ */
+static uint32_t sgl_span_mix_bytes(uint8_t *out, const uint8_t *fg, const uint8_t *bg, uint8_t factor, uint32_t len)
+{
+    sgl_vu16_t f = (sgl_vu16_t){0} + factor;
+    sgl_vu16_t inv = 256 - f;
+    sgl_vu8_t a, b;
+    uint32_t i = 0;
+
+    for (; i + SGL_SPAN_BYTES <= len; i += SGL_SPAN_BYTES) {
+        sgl_vec_load(a, fg + i);
+        sgl_vec_load(b, bg + i);
+        a = sgl_vec_cast((sgl_vec_cast(a, sgl_vu16_t) * f + sgl_vec_cast(b, sgl_vu16_t) * inv) >> 8, sgl_vu8_t);
+        sgl_vec_store(out + i, a);
+    }
+    return i;
+}
+
+
+static uint32_t sgl_span_fill_vec(sgl_color_t *dst, sgl_color_t color, uint32_t len)
+{
+    uint32_t done = 1, n = 0;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    /* the filled part is copied to the rest, so one copy is done in double size every time */
+    dst[0] = color;
+    while (done < len) {
+        n = sgl_min(done, len - done);
+        memcpy(dst + done, dst, n * sizeof(sgl_color_t));
+        done += n;
+    }
+    return len;
+}
+
+
+static uint32_t sgl_span_blend_vec(sgl_color_t *dst, sgl_color_t color, uint8_t alpha, uint32_t len)
+{
+    sgl_color_t pattern[SGL_SPAN_PATTERN_LEN];
+    uint32_t i = 0;
+
+    if (len < SGL_SPAN_PATTERN_LEN) {
+        return 0;
+    }
+
+    for (int k = 0; k < SGL_SPAN_PATTERN_LEN; k++) {
+        pattern[k] = color;
+    }
+
+    for (; i + SGL_SPAN_PATTERN_LEN <= len; i += SGL_SPAN_PATTERN_LEN) {
+        sgl_span_mix_bytes((uint8_t*)(dst + i), (uint8_t*)pattern, (uint8_t*)(dst + i), alpha, sizeof(pattern));
+    }
+    return i;
+}
+
+
+/* the coverage of 24 bit pixels is not in lanes, it is blended by scalar loop */
+#define  sgl_span_blend_mask_vec(dst, color, mask, alpha, len)  (0)
+
+
+static uint32_t sgl_span_mix_vec(sgl_color_t *out, const sgl_color_t *fg, const sgl_color_t *bg, uint8_t factor, uint32_t len)
+{
+    /* the output may be one of inputs, so the vector loop must not stop in the middle of pixel */
+    uint32_t n = len - len % SGL_SPAN_BYTES;
+
+    sgl_span_mix_bytes((uint8_t*)out, (const uint8_t*)fg, (const uint8_t*)bg, factor, n * sizeof(sgl_color_t));
+    return n;
+}
+
+#else
+
+#define  sgl_span_fill_vec(dst, color, len)                     (0)
+#define  sgl_span_blend_vec(dst, color, alpha, len)             (0)
+#define  sgl_span_blend_mask_vec(dst, color, mask, alpha, len)  (0)
+#define  sgl_span_mix_vec(out, fg, bg, factor, len)             (0)
+
+#endif
+
+
+/**
+ * @brief fill a span of pixels with solid color
+ * @param dst point to the first pixel of span
+ * @param color color of span
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_fill(sgl_color_t *dst, sgl_color_t color, uint32_t len)
+{
+    uint32_t i = sgl_span_fill_vec(dst, color, len);
+
+    for (; i < len; i++) {
+        dst[i] = color;
+    }
+}
+
+
+/**
+ * @brief blend a solid color into a span of pixels with constant alpha
+ * @param dst point to the first pixel of span
+ * @param color color of span
+ * @param alpha alpha of color, SGL_ALPHA_MAX means fill
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_blend(sgl_color_t *dst, sgl_color_t color, uint8_t alpha, uint32_t len)
+{
+    uint32_t i = 0;
+
+    if (alpha == SGL_ALPHA_MAX) {
+        sgl_span_fill(dst, color, len);
+        return;
+    }
+    else if (alpha == SGL_ALPHA_MIN) {
+        return;
+    }
+
+    i = sgl_span_blend_vec(dst, color, alpha, len);
+    for (; i < len; i++) {
+        dst[i] = sgl_color_mixer(color, dst[i], alpha);
+    }
+}
+
+
+/**
+ * @brief blend a solid color into a span of pixels with per-pixel coverage and constant alpha
+ * @param dst point to the first pixel of span
+ * @param color color of span
+ * @param mask coverage of every pixel, 0 means the pixel is not touched, SGL_ALPHA_MAX means solid
+ * @param alpha alpha of color
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_blend_mask(sgl_color_t *dst, sgl_color_t color, const uint8_t *mask, uint8_t alpha, uint32_t len)
+{
+    uint32_t i = 0;
+
+    if (alpha == SGL_ALPHA_MIN) {
+        return;
+    }
+
+    i = sgl_span_blend_mask_vec(dst, color, mask, alpha, len);
+    for (; i < len; i++) {
+        if (mask[i] == SGL_ALPHA_MIN) {
+            continue;
+        }
+        else if (mask[i] == SGL_ALPHA_MAX) {
+            dst[i] = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, dst[i], alpha));
+        }
+        else {
+            dst[i] = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, dst[i], mask[i]) : sgl_color_mixer(sgl_color_mixer(color, dst[i], mask[i]), dst[i], alpha));
+        }
+    }
+}
+
+
+/**
+ * @brief copy a row of source pixels into a span of pixels with constant alpha
+ * @param dst point to the first pixel of span
+ * @param src point to the first source pixel, it must not overlap with span
+ * @param alpha alpha of source, SGL_ALPHA_MAX means copy
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_copy(sgl_color_t *dst, const sgl_color_t *src, uint8_t alpha, uint32_t len)
+{
+    uint32_t i = 0;
+
+    if (alpha == SGL_ALPHA_MAX) {
+        memcpy(dst, src, len * sizeof(sgl_color_t));
+        return;
+    }
+    else if (alpha == SGL_ALPHA_MIN) {
+        return;
+    }
+
+    i = sgl_span_mix_vec(dst, src, dst, alpha, len);
+    for (; i < len; i++) {
+        dst[i] = sgl_color_mixer(src[i], dst[i], alpha);
+    }
+}
+
+
+/**
+ * @brief Blends foreground and background colors using a specified alpha blending factor, applied to multiple pixels.
+ * @param fg_color Pointer to the foreground colors, it receives the blended colors
+ * @param bg_color Pointer to the background colors
+ * @param factor   Blending factor: 0 = fully transparent, 255 = fully opaque
+ * @param len      Number of pixels
+ * @return none
+ */
+void sgl_color_blend(sgl_color_t *fg_color, sgl_color_t *bg_color, uint8_t factor, uint32_t len)
+{
+    uint32_t i = sgl_span_mix_vec(fg_color, fg_color, bg_color, factor, len);
+
+    for (; i < len; i++) {
+        fg_color[i] = sgl_color_mixer(fg_color[i], bg_color[i], factor);
+    }
+}
@@ -50,14 +50,6 @@ typedef struct {
     sgl_font_rle_state_t state;
 } sgl_font_rle_t;
 
-static sgl_font_rle_t font_rle = {
-    .rdp = 0,
-    .in = NULL,
-    .bpp = 0,
-    .prev_v = 0,
-    .count = 0,
-    .state = RLE_STATE_SINGLE,
-};
 
 /**
  * @brief Get bits from a byte array
@@ -97,16 +89,16 @@ static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len
 
 /**
  * @brief Decompress a line of RLE data
+ * @param rle the RLE decompress state
  * @param out the decompressed data
  * @param w the width of the decompressed data
  * @return none
  */
-static inline void decompress_line(uint8_t *out, int32_t w)
+static inline void decompress_line(sgl_font_rle_t *rle, uint8_t *out, int32_t w)
 {
     int32_t i;
     uint8_t v = 0;
     uint8_t ret = 0;
-    sgl_font_rle_t *rle = &font_rle;
 
     for(i = 0; i < w; i++) {
         if(rle->state == RLE_STATE_SINGLE) {
@@ -164,18 +156,20 @@ static inline void decompress_line(uint8_t *out, int32_t w)
 
 /**
  * @brief Initialize the RLE decompression state
+ * @param rle the RLE decompress state
  * @param in Pointer to the input data
  * @param bpp Bits per pixel of the input data
  * @return none
+ * @note the state lives on the stack of caller, so that the characters can be drawn in parallel
  */
-static inline void font_rle_init(const uint8_t * in, uint8_t bpp)
+static inline void font_rle_init(sgl_font_rle_t *rle, const uint8_t * in, uint8_t bpp)
 {
-    font_rle.in = in;
-    font_rle.bpp = bpp;
-    font_rle.state = RLE_STATE_SINGLE;
-    font_rle.rdp = 0;
-    font_rle.prev_v = 0;
-    font_rle.count = 0;
+    rle->in = in;
+    rle->bpp = bpp;
+    rle->state = RLE_STATE_SINGLE;
+    rle->rdp = 0;
+    rle->prev_v = 0;
+    rle->count = 0;
 }
 #endif // (!CONFIG_SGL_FONT_COMPRESSED)
 
@@ -258,15 +252,16 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
     }  /* support compressed font */
     else {
         uint8_t line_buf[128] = {0};
-        font_rle_init(dot, font->bpp);
+        sgl_font_rle_t rle;
+        font_rle_init(&rle, dot, font->bpp);
 
         for (int y = text_rect.y1; y < clip.y1; y++) {
-            decompress_line(NULL, font_w);
+            decompress_line(&rle, NULL, font_w);
         }
 
         for (int y = clip.y1; y <= clip.y2; y++) {
             blend = buf;
-            decompress_line(line_buf, font_w);
+            decompress_line(&rle, line_buf, font_w);
 
             for (int x = clip.x1; x <= clip.x2; x++) {
                 if (font->bpp == 4) {
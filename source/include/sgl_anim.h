@@ -168,6 +168,16 @@ void sgl_anim_add(sgl_anim_t *anim);
 void sgl_anim_remove(sgl_anim_t *anim);
 
 
+/**
+ * @brief stop the animations whose data is an object of a subtree
+ * @param  obj root of subtree
+ * @return none
+ * @note   it must be called before the objects are freed, the animations that are freed
+ *         automatically are freed here, the others are still owned by application
+*/
+void sgl_anim_remove_obj(sgl_obj_t *obj);
+
+
 /**
  * @brief start animation
  * @param  anim animation object
@@ -346,6 +356,15 @@ static inline void sgl_anim_set_auto_free(sgl_anim_t *anim)
 void sgl_anim_task(void);
 
 
+/**
+ * @brief get the time until the next animation step
+ * @param  none
+ * @return 0 if any animation is running, the remaining delay of the nearest animation otherwise,
+ *         SGL_TASK_DEADLINE_IDLE if there is no animation
+ */
+uint32_t sgl_anim_next_deadline(void);
+
+
 /**
  * Linear animation path calculation function
  * 
@@ -59,19 +59,92 @@ extern "C" {
  * CONFIG_SGL_EVENT_QUEUE_SIZE:
  *      the size of event queue, default: 32
  * 
+ * CONFIG_SGL_EVENT_QUEUE_MPSC:
+ *      If the events are sent from more than one thread, please define this macro to 1, the event
+ *      queue is safe for many producers, it needs C11 atomics, default: 0
+ * 
+ * CONFIG_SGL_EVENT_MOTION_MERGE:
+ *      If you want the motions of input device to be merged when they are not handled, please define
+ *      this macro to 1, so the queue is not filled by fast touch and at most one motion is handled
+ *      between press and release in one frame, it needs C11 atomics, default: 1
+ * 
  * CONFIG_SGL_EVENT_CLICK_INTERVAL:
  *      The click interval, default: 10
  * 
+ * CONFIG_SGL_EVENT_HIT_INDEX_MAX:
+ *      The max number of entries in the hit index, the screen is split into a grid and the objects are
+ *      stored in the cells that they cover, it is rebuilt lazily after the object tree is changed, so
+ *      the hit test only checks the objects in one cell, 0 means walk object tree for each hit test,
+ *      default: 256
+ * 
+ * CONFIG_SGL_DIRTY_AREA_THRESHOLD:
+ *      The percent of screen pixels, when the dirty area is larger than it, the whole screen is redrawn
+ *      with one rectangle, 0 means disable, default: 64
+ * 
+ * CONFIG_SGL_DIRTY_AREA_RECT_COST:
+ *      The cost of one more dirty rectangle in pixels, such as binning objects and flushing setup, two
+ *      dirty areas are merged if the wasted pixels of the merged area are not more than it, default: 512
+ * 
+ * CONFIG_SGL_DISPLAY_LIST_MAX:
+ *      The max number of visible objects in display list, the object tree is flattened into display list
+ *      once per frame and reused by all dirty areas and slices, 0 means walk object tree for each slice,
+ *      default: 128
+ * 
+ * CONFIG_SGL_OCCLUSION_CULLING:
+ *      If you want to skip the objects that are completely covered by opaque objects, please define
+ *      this macro to 1, it works with display list only, default: 1
+ * 
+ * CONFIG_SGL_RENDER_THREADS:
+ *      The number of threads that draw a slice in parallel, the slice is split into horizontal bands,
+ *      it needs pthread and display list, and the heap must be thread safe if widgets allocate memory
+ *      while drawing, 0 or 1 means draw in current thread only, default: 0
+ * 
+ * CONFIG_SGL_TRANSLATE_NUM_MAX:
+ *      The maximum number of containers that are moved or scrolled lazily in one frame, the children
+ *      of them are moved once in dirty calculation instead of every move, 0 means disable, default: 4
+ *      With CONFIG_SGL_USE_FBDEV_VRAM, the scrolled views and moved opaque objects are copied in
+ *      framebuffer by copy_area callback or cpu, and only the exposed parts are drawn again
+ * 
+ * CONFIG_SGL_DRAW_BUFFER_MAX:
+ *      The maximum number of draw buffers in the flush ring, the renderer draws the next slice into a
+ *      free buffer while the previous slices are still flushing, default: 2
+ * 
+ * CONFIG_SGL_MM_TAG:
+ *      If you want to know the heap memory that is used by objects, fonts, images and scratch buffers,
+ *      please define this macro to 1, the memory that is allocated by sgl_malloc_tagged is attributed to
+ *      the tag, and reported in sgl_mm_get_monitor(), default: 0
+ * 
+ * CONFIG_SGL_SCRATCH_SIZE:
+ *      The size of scratch arena in bytes, the transient buffers of drawing are allocated from it and
+ *      released at the end of every frame, the buffers are allocated from heap if it is full, please
+ *      check sgl_scratch_get_peak() to find the right size, 0 means use heap, default: 4096
+ * 
  * CONFIG_SGL_OBJ_SLOT_DYNAMIC
  *      If the object slot is dynamic, the object slot size will be dynamic allocated, otherwise, the object 
  *      slot size will be static allocated that you should define CONFIG_SGL_OBJ_NUM_MAX macro
+ *      The objects are allocated from the free lists of size classes, the slots are allocated from heap
+ *      in small chunks and never returned, so creating and destroying pages does not fragment heap
  * 
  * CONFIG_SGL_OBJ_NUM_MAX:
  *      If CONFIG_SGL_OBJ_SLOT_DYNAMIC is 0 or not defined, you should define CONFIG_SGL_OBJ_NUM_MAX macro
+ *      The static slot pool can hold the number of objects at least, if both macros are 0, the objects
+ *      are allocated from heap directly, default: 0
  * 
  * CONFIG_SGL_PIXMAP_BILINEAR_INTERP:
  *      If you want to use pixmap bilinear interpolation, please define this macro to 1
  * 
+ * CONFIG_SGL_DRAW_SIMD:
+ *      If you want the span kernels of drawing to use vector instructions, please define this macro
+ *      to 1, it needs GCC or clang and works on the targets with SSE2, AVX2 or NEON only, the other
+ *      targets use the scalar kernels, default: 1
+ * 
+ * CONFIG_SGL_DRAW_MASK_CACHE:
+ *      The static memory in bytes that keeps the coverage masks of circles, rings and round corners,
+ *      the masks of same radius are drawn by blending the cached coverage instead of computing the
+ *      edges again, it is split evenly among the render threads, the oldest masks are overwritten
+ *      when it is full, a mask of radius 20 takes about 400 bytes on 32 bit targets, 0 means no
+ *      cache, default: 0
+ * 
  * CONFIG_SGL_ANIMATION:
  *      If you want to use animation, please define this macro to 1
  * 
@@ -81,6 +154,29 @@ extern "C" {
  * CONFIG_SGL_USE_OBJ_ID:
  *      If you want to use obj id, please define this macro to 1, at mostly, the CONFIG_SGL_USE_OBJ_ID should be 0
  * 
+ * CONFIG_SGL_OBJ_COMPACT:
+ *      If you want to save the memory of objects, please define this macro to 1, the event callback,
+ *      event data and name of object are moved into a block that is allocated when they are set, so
+ *      the objects without event callback save two pointers, default: 0
+ * 
+ * CONFIG_SGL_OBJ_USE_PREV:
+ *      If you want to insert, remove and reorder children in O(1), please define this macro to 1, every
+ *      object keeps one more pointer to its previous sibling, 0 means walk sibling list to save the
+ *      pointer on small targets, default: 0
+ * 
+ * CONFIG_SGL_OBJ_FREE_BUDGET:
+ *      The max number of deleted objects that are freed after every frame, the damage of deleted objects
+ *      is drawn at once, but the memory is given back a few per frame, so deleting a large page does
+ *      not stall one frame. 0 means free the objects when they are deleted, default: 0
+ * 
+ * CONFIG_SGL_PAGEMGR_NUM:
+ *      The max number of pages that are registered into page manager, the pages are built when they
+ *      are loaded and kept in a LRU list, 0 means no page manager, default: 0
+ * 
+ * CONFIG_SGL_PAGEMGR_BUDGET:
+ *      The used memory in bytes that page manager keeps under, the pages that are not used for the
+ *      longest time are evicted when it is exceeded, 0 means never evict, default: 0
+ * 
  * CONFIG_SGL_HEAP_ALGO:
  *      The heap algorithm, default: lwmem
  * 
@@ -129,6 +225,14 @@ extern "C" {
 #define CONFIG_SGL_EVENT_QUEUE_SIZE                                (16)
 #endif
 
+#ifndef CONFIG_SGL_EVENT_QUEUE_MPSC
+#define CONFIG_SGL_EVENT_QUEUE_MPSC                                (0)
+#endif
+
+#ifndef CONFIG_SGL_EVENT_MOTION_MERGE
+#define CONFIG_SGL_EVENT_MOTION_MERGE                              (1)
+#endif
+
 #ifndef CONFIG_SGL_EVENT_CLICK_INTERVAL
 #define CONFIG_SGL_EVENT_CLICK_INTERVAL                            (10)
 #endif
@@ -137,10 +241,60 @@ extern "C" {
 #define CONFIG_SGL_DIRTY_AREA_NUM_MAX                              (16)
 #endif
 
+#ifndef CONFIG_SGL_DIRTY_AREA_THRESHOLD
+#define CONFIG_SGL_DIRTY_AREA_THRESHOLD                            (64)
+#endif
+
+#ifndef CONFIG_SGL_DIRTY_AREA_RECT_COST
+#define CONFIG_SGL_DIRTY_AREA_RECT_COST                            (512)
+#endif
+
+#ifndef CONFIG_SGL_EVENT_HIT_INDEX_MAX
+#define CONFIG_SGL_EVENT_HIT_INDEX_MAX                             (256)
+#endif
+
+#ifndef CONFIG_SGL_DISPLAY_LIST_MAX
+#define CONFIG_SGL_DISPLAY_LIST_MAX                                (128)
+#endif
+
+#ifndef CONFIG_SGL_OCCLUSION_CULLING
+#   define CONFIG_SGL_OCCLUSION_CULLING                            (1)
+#endif
+
+#if (CONFIG_SGL_DISPLAY_LIST_MAX == 0)
+#   undef CONFIG_SGL_OCCLUSION_CULLING
+#   define CONFIG_SGL_OCCLUSION_CULLING                            (0)
+#endif
+
+#ifndef CONFIG_SGL_RENDER_THREADS
+#   define CONFIG_SGL_RENDER_THREADS                               (0)
+#endif
+
+#if (CONFIG_SGL_DISPLAY_LIST_MAX == 0)
+#   undef CONFIG_SGL_RENDER_THREADS
+#   define CONFIG_SGL_RENDER_THREADS                               (0)
+#endif
+
+#ifndef CONFIG_SGL_TRANSLATE_NUM_MAX
+#define CONFIG_SGL_TRANSLATE_NUM_MAX                               (4)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_BUFFER_MAX
+#define CONFIG_SGL_DRAW_BUFFER_MAX                                 (2)
+#endif
+
 #ifndef CONFIG_SGL_PIXMAP_BILINEAR_INTERP
 #define CONFIG_SGL_PIXMAP_BILINEAR_INTERP                          (0)
 #endif
 
+#ifndef CONFIG_SGL_DRAW_SIMD
+#define CONFIG_SGL_DRAW_SIMD                                       (1)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_MASK_CACHE
+#define CONFIG_SGL_DRAW_MASK_CACHE                                 (0)
+#endif
+
 #ifndef CONFIG_SGL_ANIMATION
 #define CONFIG_SGL_ANIMATION                                       (0)
 #endif
@@ -160,6 +314,42 @@ extern "C" {
 #define CONFIG_SGL_OBJ_USE_NAME                                    (0)
 #endif
 
+#ifndef CONFIG_SGL_MM_TAG
+#define CONFIG_SGL_MM_TAG                                          (0)
+#endif
+
+#ifndef CONFIG_SGL_SCRATCH_SIZE
+#define CONFIG_SGL_SCRATCH_SIZE                                    (4096)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_SLOT_DYNAMIC
+#define CONFIG_SGL_OBJ_SLOT_DYNAMIC                                (0)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_NUM_MAX
+#define CONFIG_SGL_OBJ_NUM_MAX                                     (0)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_COMPACT
+#define CONFIG_SGL_OBJ_COMPACT                                     (0)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_USE_PREV
+#define CONFIG_SGL_OBJ_USE_PREV                                    (0)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_FREE_BUDGET
+#define CONFIG_SGL_OBJ_FREE_BUDGET                                 (0)
+#endif
+
+#ifndef CONFIG_SGL_PAGEMGR_NUM
+#define CONFIG_SGL_PAGEMGR_NUM                                     (0)
+#endif
+
+#ifndef CONFIG_SGL_PAGEMGR_BUDGET
+#define CONFIG_SGL_PAGEMGR_BUDGET                                  (0)
+#endif
+
 #ifndef CONFIG_SGL_HEAP_ALGO
 #define CONFIG_SGL_HEAP_ALGO                                       (lwmem)
 #endif
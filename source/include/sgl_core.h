@@ -41,9 +41,11 @@ extern "C" {
 /* the maximum depth of object*/
 #define  SGL_OBJ_DEPTH_MAX                 (16)
 /* the maximum number of drawing buffers */
-#define  SGL_DRAW_BUFFER_MAX               (2)
+#define  SGL_DRAW_BUFFER_MAX               CONFIG_SGL_DRAW_BUFFER_MAX
 /* define default animation tick ms */
 #define  SGL_SYSTEM_TICK_MS                CONFIG_SGL_SYSTICK_MS
+/* the deadline of task when there is nothing to animate, draw or handle */
+#define  SGL_TASK_DEADLINE_IDLE            (UINT32_MAX)
 
 
 #if (CONFIG_SGL_DIRTY_AREA_NUM_MAX)
@@ -232,6 +234,7 @@ typedef union {
  * @w:      surf width
  * @h:      surf height
  * @dirty:  pointer to dirty area
+ * @band:   index of the render band that draws the surface, only present if CONFIG_SGL_RENDER_THREADS > 1
  */
 typedef struct sgl_surf {
     int16_t      x1;
@@ -243,6 +246,9 @@ typedef struct sgl_surf {
     uint16_t     w;
     uint16_t     h;
     sgl_area_t   *dirty;
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+    uint8_t      band;
+#endif
 } sgl_surf_t;
 
 
@@ -358,12 +364,12 @@ typedef struct sgl_font {
  * Members:
  * @area: The logical size (width, height) of the object, used for layout and measurement.
  * @coords: The current screen position (x, y) and dimensions after layout calculation.
- * @event_fn: Callback function invoked when an event (e.g., touch, click) targets this object.
- * @event_data: User-defined context data passed to the event callback.
  * @construct_fn: Initialization hook called during object creation to allocate resources or set defaults.
  * @parent: Pointer to the parent object; NULL if this is a root-level object.
  * @child: Pointer to the first child in the list of children.
  * @sibling: Pointer to the next sibling under the same parent.
+ * @prev: [Optional] Pointer to the previous sibling, the first child points to the last child, so
+ *        the tail and the previous sibling are found in O(1). Only present if CONFIG_SGL_OBJ_USE_PREV is 1.
  * @destroyed: (1 bit) Set to 1 when the object is marked for destruction.
  * @dirty: (1 bit) Set to 1 when the object needs to be redrawn.
  * @hide: (1 bit) Set to 1 to exclude the object from rendering (hidden).
@@ -380,19 +386,29 @@ typedef struct sgl_font {
  * @evt_leave: (1 bit) Set to 1 if the object should receive "pointer leave" events.
  * @pressed: (1 bit) Tracks whether the object is currently being pressed.
  * @page: (1 bit) Reserved for page/view switching logic (e.g., in tabbed interfaces).
- * @radius: (12 bits) Corner radius in pixels for rounded rectangle rendering (max 4095).
+ * @opaque: (1 bit) Set to 1 if the object paints every pixel of its area with full alpha, the
+ *          objects that are completely covered by it will not be drawn.
+ * @child_dirty: (1 bit) Set to 1 if any descendant is dirty, destroyed, needs init or is shown again,
+ *               the clean subtrees are skipped when calculating dirty area.
+ * @radius: (10 bits) Corner radius in pixels for rounded rectangle rendering (max 1022).
+ * @event_fn: Callback function invoked when an event (e.g., touch, click) targets this object.
+ * @event_data: User-defined context data passed to the event callback.
  * @name: [Optional] Null-terminated string identifier for debugging or lookup.
  *        Only present if CONFIG_SGL_OBJ_USE_NAME is defined.
+ * @ext: [Optional] Pointer to the cold members (event_fn, event_data and name), it is allocated when
+ *       they are set, NULL means they are not set. Only present if CONFIG_SGL_OBJ_COMPACT is 1.
+ * @note The members that are used to traverse object tree are placed at the front.
  */
 typedef struct sgl_obj {
     sgl_area_t      area;
     sgl_area_t      coords;
-    void            (*event_fn)(sgl_event_t *e);
-    size_t          event_data;
-    void            (*construct_fn)(sgl_surf_t *surf, struct sgl_obj *obj, sgl_event_t *event);
     struct sgl_obj  *parent;
     struct sgl_obj  *child;
     struct sgl_obj  *sibling;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+    struct sgl_obj  *prev;
+#endif
+    void            (*construct_fn)(sgl_surf_t *surf, struct sgl_obj *obj, sgl_event_t *event);
     uint8_t         destroyed : 1;
     uint8_t         dirty : 1;
     uint8_t         hide : 1;
@@ -405,13 +421,39 @@ typedef struct sgl_obj {
     uint16_t        focus : 1;
     uint16_t        pressed : 1;
     uint16_t        page : 1;
-    uint16_t        radius : 12;
+    uint16_t        opaque : 1;
+    uint16_t        child_dirty : 1;
+    uint16_t        radius : 10;
+#if (CONFIG_SGL_OBJ_COMPACT)
+    struct sgl_obj_ext *ext;
+#else
+    void            (*event_fn)(sgl_event_t *e);
+    size_t          event_data;
 #if CONFIG_SGL_OBJ_USE_NAME
     const char      *name;
 #endif
+#endif
 } sgl_obj_t;
 
 
+#if (CONFIG_SGL_OBJ_COMPACT)
+/**
+ * @brief The cold members of object, they are not used to traverse object tree and most objects
+ *        have no event callback, so they are allocated only when they are set.
+ * @event_fn: Callback function invoked when an event (e.g., touch, click) targets this object.
+ * @event_data: User-defined context data passed to the event callback.
+ * @name: [Optional] Null-terminated string identifier for debugging or lookup.
+ */
+typedef struct sgl_obj_ext {
+    void            (*event_fn)(sgl_event_t *e);
+    size_t          event_data;
+#if CONFIG_SGL_OBJ_USE_NAME
+    const char      *name;
+#endif
+} sgl_obj_ext_t;
+#endif
+
+
 /**
  * @brief Represents a page object in the SGL graphics system.
  *
@@ -439,7 +481,14 @@ typedef struct sgl_page {
  * @buffer_size: framebuffer size
  * @xres: x resolution
  * @yres: y resolution
- * @flush_area: flush area callback function pointer, return the finished flag
+ * @flush_area: flush area callback function pointer, the flush can be finished asynchronously,
+ *              and you must call sgl_fbdev_flush_ready when the flush is finished
+ * @flush_wait: [optional] wait callback function pointer, it is called when all draw buffers are
+ *              flushing, it should block until sgl_fbdev_flush_ready is called, such as taking
+ *              a semaphore, if it is NULL, sgl will busy wait
+ * @copy_area: [optional] copy area callback function pointer, it is only used when the framebuffer
+ *             is VRAM, it copies the pixels of src area to dst area in framebuffer, the two areas
+ *             have the same size and may overlap, such as a 2D DMA, if it is NULL, cpu copies them
  */
 typedef struct sgl_fbinfo {
     void      *buffer[SGL_DRAW_BUFFER_MAX];
@@ -447,26 +496,50 @@ typedef struct sgl_fbinfo {
     int16_t    xres;
     int16_t    yres;
     void       (*flush_area)(sgl_area_t *area, sgl_color_t *src);
+    void       (*flush_wait)(void);
+    void       (*copy_area)(sgl_area_t *dst, sgl_area_t *src);
 } sgl_fbinfo_t;
 
 
+/**
+ * @brief dirty area statistics, it is used to tune the dirty area merging
+ * @damaged: number of pixels that are really damaged
+ * @redrawn: number of pixels that are redrawn
+ * @rects: number of dirty rectangles that are redrawn
+ * @fallback: number of times that the dirty area falls back to full screen
+ */
+typedef struct sgl_dirty_stat {
+    uint64_t          damaged;
+    uint64_t          redrawn;
+    uint32_t          rects;
+    uint32_t          fallback;
+} sgl_dirty_stat_t;
+
+
 /**
  * @brief sgl framebuffer device struct
  * @fbinfo: framebuffer information, that specify the memory address of the framebuffer and resolution
  * @surf: Drawing surface associated with this page; defines the target buffer or area for rendering.
  * @dirty_num: dirty area number
- * @fb_swap: framebuffer swap flag
- * @fb_status: framebuffer status flag
- * @dirty: dirty area pool
+ * @fb_num: number of draw buffers in the flush ring
+ * @fb_index: index of the draw buffer that is being drawn
+ * @fb_submit: number of slices that are submitted to flush, only written by drawing
+ * @fb_done: number of slices that are flushed completely, only written by sgl_fbdev_flush_ready,
+ *          it is published with release and read with acquire, the flush may complete in ISR or DMA thread
+ * @dirty: dirty area pool, the areas are not overlapped with each other
+ * @dirty_stat: dirty area statistics
  * @page: current page
  */
 typedef struct sgl_fbdev {
     sgl_fbinfo_t      fbinfo;
     sgl_surf_t        surf;
     uint16_t          dirty_num;
-    volatile uint8_t  fb_swap;
-    volatile uint8_t  fb_status;
+    uint8_t           fb_num;
+    uint8_t           fb_index;
+    sgl_atomic_uint_t fb_submit;
+    sgl_atomic_uint_t fb_done;
     sgl_area_t        dirty[SGL_DIRTY_AREA_NUM_MAX];
+    sgl_dirty_stat_t  dirty_stat;
     sgl_obj_t         *active;
 } sgl_fbdev_t;
 
@@ -475,12 +548,16 @@ typedef struct sgl_fbdev {
  * @brief sgl log print device struct
  * @logdev: log print callback function pointer
  * @tick_ms: tick milliseconds
+ * @hit_dirty: the object tree is changed after the hit index of event is built
  */
 typedef struct sgl_system {
     void               (*logdev)(const char *str);
     sgl_fbdev_t        fbdev;
     volatile uint32_t  tick_ms;
     const sgl_font_t   *font;
+#if (CONFIG_SGL_EVENT_HIT_INDEX_MAX)
+    bool               hit_dirty;
+#endif
 #if (CONFIG_SGL_FBDEV_ROTATION != 0)
     sgl_color_t        *rotation;
 #elif (CONFIG_SGL_FBDEV_RUNTIME_ROTATION)
@@ -581,23 +658,51 @@ int sgl_fbdev_register(sgl_fbinfo_t *fbinfo);
  */
 static inline void sgl_fbdev_flush_ready(void)
 {
-    sgl_system.fbdev.fb_status |= (1 << sgl_system.fbdev.fb_swap);
-
-    /* change to next framebuffer */
-    if (sgl_system.fbdev.fbinfo.buffer[1] != NULL) {
-        sgl_system.fbdev.surf.buffer = (sgl_color_t *)sgl_system.fbdev.fbinfo.buffer[sgl_system.fbdev.fb_swap ^= 1];
-    }
+    /* the slices are flushed in order, so the oldest flushing buffer is free now */
+    sgl_atomic_inc(&sgl_system.fbdev.fb_done, release);
 }
 
 
 /**
  * @brief check if framebuffer device buffer need to wait ready
  * @param fbdev point to the framebuffer device
- * @return bool true if need to wait ready, false if not
+ * @return bool true if all draw buffers are flushing, false if there is a free draw buffer
  */
 static inline bool sgl_fbdev_flush_wait_ready(sgl_fbdev_t *fbdev)
 {
-    return (fbdev->fb_status & (1 << sgl_system.fbdev.fb_swap)) == 0;
+    uint32_t done = sgl_atomic_load(&fbdev->fb_done, acquire);
+    return (uint32_t)(sgl_atomic_load(&fbdev->fb_submit, relaxed) - done) >= fbdev->fb_num;
+}
+
+
+/**
+ * @brief wait until the number of flushing slices is not more than pending
+ * @param fbdev point to the framebuffer device
+ * @param pending the max number of slices that can be still flushing
+ * @return none
+ * @note if the flush_wait callback is set, it is used to wait, otherwise busy wait
+ */
+static inline void sgl_fbdev_flush_wait(sgl_fbdev_t *fbdev, uint32_t pending)
+{
+    while ((uint32_t)(sgl_atomic_load(&fbdev->fb_submit, relaxed) - sgl_atomic_load(&fbdev->fb_done, acquire)) > pending) {
+        if (fbdev->fbinfo.flush_wait != NULL) {
+            fbdev->fbinfo.flush_wait();
+        }
+    }
+}
+
+
+/**
+ * @brief submit area to framebuffer device flush callback
+ * @param area area of flush
+ * @param src source color
+ * @return none
+ * @note the submit count must be increased before flush, because the flush may be finished in callback
+ */
+static inline void sgl_fbdev_flush_submit(sgl_area_t *area, sgl_color_t *src)
+{
+    sgl_atomic_inc(&sgl_system.fbdev.fb_submit, relaxed);
+    sgl_system.fbdev.fbinfo.flush_area(area, src);
 }
 
 
@@ -674,6 +779,9 @@ static inline void sgl_fbdev_flush_area(sgl_area_t *area, sgl_color_t *src)
     uint16_t height = area->y2 - area->y1 + 1;
     sgl_area_t area_dst = *area;
 
+    /* there is only one rotation buffer, wait for previous flush to finish */
+    sgl_fbdev_flush_wait(&sgl_system.fbdev, 0);
+
 #if (CONFIG_SGL_FBDEV_ROTATION == 90)
     sgl_fbdev_rotate_90(area_dst, area, sgl_system.rotation, src);
 #elif (CONFIG_SGL_FBDEV_ROTATION == 180)
@@ -683,16 +791,21 @@ static inline void sgl_fbdev_flush_area(sgl_area_t *area, sgl_color_t *src)
 #else
 #error "CONFIG_SGL_FBDEV_ROTATION is invalid rotation value (only 0/90/180/270 supported)"
 #endif
-    sgl_system.fbdev.fbinfo.flush_area(&area_dst, sgl_system.rotation);
+    sgl_fbdev_flush_submit(&area_dst, sgl_system.rotation);
 #elif (CONFIG_SGL_FBDEV_RUNTIME_ROTATION)
     uint16_t width = area->x2 - area->x1 + 1;
     uint16_t height = area->y2 - area->y1 + 1;
     sgl_area_t area_dst = *area;
 
-    switch (sgl_system.angle) {
-    case 0:
-        sgl_system.fbdev.fbinfo.flush_area(area, src);
+    if (sgl_system.angle == 0) {
+        sgl_fbdev_flush_submit(area, src);
         return;
+    }
+
+    /* there is only one rotation buffer, wait for previous flush to finish */
+    sgl_fbdev_flush_wait(&sgl_system.fbdev, 0);
+
+    switch (sgl_system.angle) {
     case 90:
         sgl_fbdev_rotate_90(area_dst, area, sgl_system.rotation, src);
         break;
@@ -706,9 +819,9 @@ static inline void sgl_fbdev_flush_area(sgl_area_t *area, sgl_color_t *src)
         SGL_LOG_ERROR("invalid angle: %d", sgl_system.angle);
         return;
     }
-    sgl_system.fbdev.fbinfo.flush_area(&area_dst, sgl_system.rotation);
+    sgl_fbdev_flush_submit(&area_dst, sgl_system.rotation);
 #else
-    sgl_system.fbdev.fbinfo.flush_area(area, src);
+    sgl_fbdev_flush_submit(area, src);
 #endif
 }
 
@@ -761,7 +874,7 @@ uint8_t sgl_pixmal_get_bytes_per_pixel(const sgl_pixmap_t *pixmap);
  * @param none
  * @return tick milliseconds
  */
-static inline uint8_t sgl_tick_get(void)
+static inline uint32_t sgl_tick_get(void)
 {
     return sgl_system.tick_ms;
 }
@@ -774,7 +887,7 @@ static inline uint8_t sgl_tick_get(void)
  * @note in general, you should call this function in the 1ms tick interrupt handler
  *       of course, you can use polling function to increase tick milliseconds.
  */
-static inline void sgl_tick_inc(uint8_t ms)
+static inline void sgl_tick_inc(uint32_t ms)
 {
     sgl_system.tick_ms += ms;
 }
@@ -863,6 +976,9 @@ static inline void sgl_obj_node_init(sgl_obj_t *obj)
 
     obj->sibling = NULL;
     obj->child = NULL;
+#if (CONFIG_SGL_OBJ_USE_PREV)
+    obj->prev = NULL;
+#endif
 }
 
 
@@ -883,6 +999,16 @@ void sgl_obj_add_child(sgl_obj_t *parent, sgl_obj_t *obj);
 void sgl_obj_remove(sgl_obj_t *obj);
 
 
+#if (CONFIG_SGL_OBJ_COMPACT)
+/**
+ * @brief get the cold members of object, they are allocated if not yet
+ * @param obj: pointer of object
+ * @return pointer of cold members, NULL if out of memory
+ */
+sgl_obj_ext_t* sgl_obj_get_ext(sgl_obj_t *obj);
+#endif
+
+
 /**
  * @brief check if object has child
  * @param  obj object
@@ -951,9 +1077,10 @@ static inline size_t sgl_obj_get_child_count(sgl_obj_t *obj)
 /**
  * @brief merge an area into global dirty area
  * 
- * This function calculates how much rectangle 'a' would need to grow in each direction (left, right, top, bottom)
- * to fully enclose both 'a' and 'b'. The result is the sum of the expansions along all four sides.
- * Note: This is not the increase in area, th is a lightweight heuristic for merge cost in bounding-box algorithms.
+ * The dirty area is a region of non-overlapping rectangles. An area is merged into a rectangle only
+ * if the wasted pixels are less than CONFIG_SGL_DIRTY_AREA_RECT_COST, otherwise the uncovered part
+ * is added as new rectangles. The region falls back to full screen when the damaged pixels exceed
+ * CONFIG_SGL_DIRTY_AREA_THRESHOLD percent of screen.
  * 
  * @param area [in] Pointer to the area
  * @return none
@@ -961,6 +1088,29 @@ static inline size_t sgl_obj_get_child_count(sgl_obj_t *obj)
 void sgl_dirty_area_push(sgl_area_t *area);
 
 
+/**
+ * @brief get dirty area statistics
+ * @param none
+ * @return sgl_dirty_stat_t* pointer to the statistics
+ * @note the redrawn pixels divided by damaged pixels is the overdraw ratio of dirty area merging
+ */
+static inline sgl_dirty_stat_t* sgl_dirty_area_get_stat(void)
+{
+    return &sgl_system.fbdev.dirty_stat;
+}
+
+
+/**
+ * @brief reset dirty area statistics
+ * @param none
+ * @return none
+ */
+static inline void sgl_dirty_area_reset_stat(void)
+{
+    sgl_system.fbdev.dirty_stat = (sgl_dirty_stat_t){ 0 };
+}
+
+
 /**
  * @brief set system font
  * @param font pointer to font
@@ -984,6 +1134,39 @@ static inline const sgl_font_t* sgl_get_system_font(void)
 }
 
 
+/**
+ * @brief mark the hit index of event to be rebuilt
+ * @param none
+ * @return none
+ * @note it must be called when the coords, visibility or order of objects are changed
+ */
+static inline void sgl_obj_hit_invalidate(void)
+{
+#if (CONFIG_SGL_EVENT_HIT_INDEX_MAX)
+    sgl_system.hit_dirty = true;
+#endif
+}
+
+
+/**
+ * @brief mark all ancestors of object that a descendant needs attention
+ * @param obj point to object
+ * @return none
+ * @note it stops at the first ancestor that is already marked, because its ancestors are marked too
+ */
+static inline void sgl_obj_set_child_dirty(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    while (obj->parent != NULL && obj->parent != obj) {
+        obj = obj->parent;
+        if (obj->child_dirty) {
+            return;
+        }
+        obj->child_dirty = 1;
+    }
+}
+
+
 /**
  * @brief  Set the object to be destroyed
  * @param  obj: the object to set
@@ -995,6 +1178,7 @@ static inline void sgl_obj_set_destroyed(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->destroyed = 1;
+    sgl_obj_set_child_dirty(obj);
 }
 
 
@@ -1020,6 +1204,7 @@ static inline void sgl_obj_set_dirty(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->dirty = 1;
+    sgl_obj_set_child_dirty(obj);
 }
 
 
@@ -1056,6 +1241,7 @@ static inline void sgl_obj_needinit(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->needinit = 1;
+    sgl_obj_set_child_dirty(obj);
 }
 
 
@@ -1083,6 +1269,45 @@ static inline void sgl_obj_clear_needinit(sgl_obj_t *obj)
 }
 
 
+/**
+ * @brief set object opaque flag
+ * @param obj point to object
+ * @return none
+ * @note only set it when the object paints every pixel of its area with full alpha, the round
+ *       corners are taken into account by sgl_obj_is_opaque
+ */
+static inline void sgl_obj_set_opaque(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    obj->opaque = 1;
+}
+
+
+/**
+ * @brief clear object opaque flag
+ * @param obj point to object
+ * @return none
+ */
+static inline void sgl_obj_clear_opaque(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    obj->opaque = 0;
+}
+
+
+/**
+ * @brief check object opaque flag
+ * @param obj point to object
+ * @return flag, true - opaque, false - maybe transparent
+ * @note the corners of a round object are transparent, so it is never opaque
+ */
+static inline bool sgl_obj_is_opaque(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    return obj->opaque && (obj->radius == 0);
+}
+
+
 /**
  * @brief set object hidden flag
  * @param obj point to object
@@ -1092,7 +1317,9 @@ static inline void sgl_obj_set_hidden(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->hide = 1;
+    sgl_obj_hit_invalidate();
     sgl_dirty_area_push(&obj->area);
+    sgl_obj_set_child_dirty(obj);
 }
 
 
@@ -1105,7 +1332,10 @@ static inline void sgl_obj_set_visible(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->hide = 0;
+    sgl_obj_hit_invalidate();
     sgl_dirty_area_push(&obj->area);
+    /* the hidden subtree was skipped, its coords may be moved, so the area is updated again */
+    sgl_obj_set_dirty(obj);
 }
 
 
@@ -1250,10 +1480,36 @@ static inline void sgl_obj_update_area(sgl_area_t *area)
  * @param ofs_x: x offset position
  * @param ofs_y: y offset position
  * @return none
+ * @note only the object is marked dirty, the coords of its descendants are updated lazily, use
+ *       sgl_obj_coords_sync before reading the coords of descendants directly
  */
 void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y);
 
 
+/**
+ * @brief scroll object child position inside a solid view of object
+ * @param obj point to object
+ * @param ofs_x: x offset position
+ * @param ofs_y: y offset position
+ * @param view: the area that object fills with one solid color under its children, NULL if none
+ * @return none
+ * @note when the framebuffer is VRAM, the pixels in view are copied in framebuffer and only the
+ *       exposed part of object is drawn again, the object must mark its own decorations that are
+ *       drawn above the children, such as scrollbar, with sgl_obj_update_area, otherwise it is
+ *       the same as sgl_obj_move_child_pos and sgl_obj_set_dirty
+ */
+void sgl_obj_scroll_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y, sgl_area_t *view);
+
+
+/**
+ * @brief update the coords of object that are moved by the pending translation of its ancestors
+ * @param obj point to object, NULL means all objects
+ * @return none
+ * @note the position functions of object call it already
+ */
+void sgl_obj_coords_sync(sgl_obj_t *obj);
+
+
 /**
  * @brief move object child x position
  * @param obj point to object
@@ -1343,6 +1599,7 @@ void sgl_obj_set_abs_pos(sgl_obj_t *obj, int16_t abs_x, int16_t abs_y);
  */
 static inline sgl_pos_t sgl_obj_get_abs_pos(sgl_obj_t *obj)
 {
+    sgl_obj_coords_sync(obj);
     sgl_pos_t pos = {
         .x = obj->coords.x1,
         .y = obj->coords.y1
@@ -1361,6 +1618,7 @@ static inline sgl_pos_t sgl_obj_get_abs_pos(sgl_obj_t *obj)
  */
 static inline void sgl_obj_set_pos(sgl_obj_t *obj, int16_t x, int16_t y)
 {
+    sgl_obj_coords_sync(obj);
     sgl_obj_set_abs_pos(obj, obj->parent->coords.x1 + x, obj->parent->coords.y1 + y);
 }
 
@@ -1374,6 +1632,7 @@ static inline void sgl_obj_set_pos(sgl_obj_t *obj, int16_t x, int16_t y)
 static inline sgl_pos_t sgl_obj_get_pos(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
+    sgl_obj_coords_sync(obj);
 
     sgl_pos_t pos;
     pos.x = obj->coords.x1 - obj->parent->coords.x1;
@@ -1391,6 +1650,7 @@ static inline sgl_pos_t sgl_obj_get_pos(sgl_obj_t *obj)
  */
 static inline void sgl_obj_set_pos_x(sgl_obj_t *obj, int16_t x)
 {
+    sgl_obj_coords_sync(obj);
     sgl_obj_set_abs_pos(obj, obj->parent->coords.x1 + x, obj->coords.y1);
 }
 
@@ -1402,6 +1662,7 @@ static inline void sgl_obj_set_pos_x(sgl_obj_t *obj, int16_t x)
  */
 static inline size_t sgl_obj_get_pos_x(sgl_obj_t *obj)
 {
+    sgl_obj_coords_sync(obj);
     return (obj->coords.x1 - obj->parent->coords.x1);
 }
 
@@ -1415,6 +1676,7 @@ static inline size_t sgl_obj_get_pos_x(sgl_obj_t *obj)
  */
 static inline void sgl_obj_set_pos_y(sgl_obj_t *obj, int16_t y)
 {
+    sgl_obj_coords_sync(obj);
     sgl_obj_set_abs_pos(obj, obj->coords.x1, obj->parent->coords.y1 + y);
 }
 
@@ -1426,6 +1688,7 @@ static inline void sgl_obj_set_pos_y(sgl_obj_t *obj, int16_t y)
  */
 static inline int16_t sgl_obj_get_pos_y(sgl_obj_t *obj)
 {
+    sgl_obj_coords_sync(obj);
     return obj->coords.y1 - obj->parent->coords.y1;
 }
 
@@ -1478,6 +1741,7 @@ static inline void sgl_obj_set_size(sgl_obj_t *obj, int16_t width, int16_t heigh
     SGL_ASSERT(obj != NULL);
     obj->coords.x2 = obj->coords.x1 + width - 1;
     obj->coords.y2 = obj->coords.y1 + height - 1;
+    sgl_obj_hit_invalidate();
     sgl_obj_set_dirty(obj);
 }
 
@@ -1507,6 +1771,7 @@ static inline void sgl_obj_set_width(sgl_obj_t *obj, int16_t width)
 {
     SGL_ASSERT(obj != NULL);
     obj->coords.x2 = obj->coords.x1 + width - 1;
+    sgl_obj_hit_invalidate();
 }
 
 
@@ -1532,6 +1797,7 @@ static inline void sgl_obj_set_height(sgl_obj_t *obj, int16_t height)
 {
     SGL_ASSERT(obj != NULL);
     obj->coords.y2 = obj->coords.y1 + height - 1;
+    sgl_obj_hit_invalidate();
 }
 
 
@@ -1601,12 +1867,59 @@ static inline sgl_area_t sgl_obj_get_fill_rect(sgl_obj_t *obj)
 static inline void sgl_obj_set_event_cb(sgl_obj_t *obj, void (*event_fn)(sgl_event_t *e), size_t data)
 {
     SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_OBJ_COMPACT)
+    sgl_obj_ext_t *ext = sgl_obj_get_ext(obj);
+    if (ext == NULL) {
+        return;
+    }
+    ext->event_fn = event_fn;
+    ext->event_data = data;
+#else
     obj->event_fn = event_fn;
     obj->event_data = data;
+#endif
     obj->clickable = 1;
 }
 
 
+/**
+ * @brief Get object event callback data
+ * @param obj point to object
+ * @return event callback data, 0 if it is not set
+ */
+static inline size_t sgl_obj_get_event_data(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_OBJ_COMPACT)
+    return obj->ext ? obj->ext->event_data : 0;
+#else
+    return obj->event_data;
+#endif
+}
+
+
+/**
+ * @brief Call object event callback function
+ * @param obj point to object
+ * @param evt point to event
+ * @return none
+ * @note nothing is done if the callback is not set
+ */
+static inline void sgl_obj_call_event_cb(sgl_obj_t *obj, sgl_event_t *evt)
+{
+    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_OBJ_COMPACT)
+    if (obj->ext && obj->ext->event_fn) {
+        obj->ext->event_fn(evt);
+    }
+#else
+    if (obj->event_fn) {
+        obj->event_fn(evt);
+    }
+#endif
+}
+
+
 /**
  * @brief set the radius of object
  * @param obj object
@@ -1668,6 +1981,37 @@ static inline sgl_page_t* sgl_page_get_active(void)
 void sgl_task_handle_sync(void);
 
 
+/**
+ * @brief set the clock of host that is used by the time budget of frame
+ * @param clock_us function that returns the time in microseconds, it may wrap around
+ * @return none
+ */
+void sgl_task_set_clock(uint32_t (*clock_us)(void));
+
+
+/**
+ * @brief sgl task handle function with time budget
+ * @param budget_us time budget of frame in microseconds
+ * @return none
+ * @note the frame draws slices until the budget is spent or an event is queued, the rest of dirty
+ *       areas is drawn by next call after the events are handled, so a large repaint does not
+ *       block the input. At least one slice is drawn in every call
+ */
+void sgl_task_handle_budget(uint32_t budget_us);
+
+
+/**
+ * @brief get the time until sgl task has work to do
+ * @param none
+ * @return milliseconds until the next frame is needed, 0 if it is needed now,
+ *         SGL_TASK_DEADLINE_IDLE if nothing is animating, dirty or queued
+ * @note the host can sleep until the deadline or until the event wake callback is called, then
+ *       increase tick by the slept time and call sgl_task_handle. The frames are not drawn faster
+ *       than SGL_SYSTEM_TICK_MS, and the pending animation delay is slept through
+ */
+uint32_t sgl_task_next_deadline(void);
+
+
 /**
  * @brief sgl task handle function
  * @param none
@@ -1681,6 +2025,12 @@ static inline void sgl_task_handle(void)
         return;
     }
 
+    /* If there is nothing to do, the frame is skipped. */
+    if (sgl_task_next_deadline() == SGL_TASK_DEADLINE_IDLE) {
+        sgl_tick_reset();
+        return;
+    }
+
     /* If the system tick time has been reached, execute the task. */
     sgl_task_handle_sync();
 }
@@ -1704,6 +2054,17 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent);
 void sgl_obj_free(sgl_obj_t *obj);
 
 
+#if (CONFIG_SGL_OBJ_FREE_BUDGET)
+/**
+ * @brief  free the objects that are deleted, at most budget objects are freed
+ * @param  budget: max number of objects to free, 0 means free all of them
+ * @retval true if all deleted objects are freed, otherwise false
+ * @note the deleted objects are freed a few per frame, call it with 0 in idle time to free all of them
+ */
+bool sgl_obj_reclaim(uint32_t budget);
+#endif
+
+
 /**
  * @brief delete object
  * @param obj point to object
@@ -1862,6 +2223,34 @@ static inline bool sgl_area_is_overlap(sgl_area_t *area_a, sgl_area_t *area_b)
 }
 
 
+/**
+ * @brief check if area a contains area b completely
+ * @param area_a area a
+ * @param area_b area b
+ * @return true if area b is inside area a, otherwise false
+ * @note: this function is unsafe, you should check the area_a and area_b is not NULL by yourself
+ */
+static inline bool sgl_area_is_contain(sgl_area_t *area_a, sgl_area_t *area_b)
+{
+    SGL_ASSERT(area_a != NULL && area_b != NULL);
+    return (area_b->x1 >= area_a->x1 && area_b->x2 <= area_a->x2 && area_b->y1 >= area_a->y1 && area_b->y2 <= area_a->y2);
+}
+
+
+/**
+ * @brief check if area a is the same as area b
+ * @param area_a area a
+ * @param area_b area b
+ * @return true if the two areas are the same, otherwise false
+ * @note: this function is unsafe, you should check the area_a and area_b is not NULL by yourself
+ */
+static inline bool sgl_area_is_equal(sgl_area_t *area_a, sgl_area_t *area_b)
+{
+    SGL_ASSERT(area_a != NULL && area_b != NULL);
+    return (area_a->x1 == area_b->x1 && area_a->x2 == area_b->x2 && area_a->y1 == area_b->y1 && area_a->y2 == area_b->y2);
+}
+
+
 /**
  * @brief check surf and other area is overlap
  * @param surf surfcare
@@ -2116,7 +2505,30 @@ double sgl_atof(const char *s);
 static inline void sgl_obj_set_name(sgl_obj_t *obj, const char *name)
 {
     SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_OBJ_COMPACT)
+    sgl_obj_ext_t *ext = sgl_obj_get_ext(obj);
+    if (ext != NULL) {
+        ext->name = name;
+    }
+#else
     obj->name = name;
+#endif
+}
+
+
+/**
+ * @brief get object name
+ * @param obj The object
+ * @return name of object, NULL if it is not set
+ */
+static inline const char* sgl_obj_get_name(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+#if (CONFIG_SGL_OBJ_COMPACT)
+    return obj->ext ? obj->ext->name : NULL;
+#else
+    return obj->name;
+#endif
 }
 
 
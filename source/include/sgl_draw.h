@@ -27,6 +27,7 @@
 
 
 #include <sgl_core.h>
+#include <sgl_math.h>
 
 
 #ifdef __cplusplus
@@ -39,6 +40,9 @@ extern "C" {
 #define  SGL_ARC_MODE_NORMAL_SMOOTH                         (2)
 #define  SGL_ARC_MODE_RING_SMOOTH                           (3)
 
+#define  SGL_LINE_CAP_ROUND                                 (0)
+#define  SGL_LINE_CAP_FLAT                                  (1)
+
 
 /**
  * @brief rect description
@@ -65,11 +69,13 @@ typedef struct sgl_draw_rect {
  * @color: line color
  * @width: line width
  * @alpha: alpha
+ * @cap: line cap of slanted lines, SGL_LINE_CAP_ROUND or SGL_LINE_CAP_FLAT
  */
 typedef struct sgl_draw_line {
     sgl_color_t      color;
     uint8_t          width;
     uint8_t          alpha;
+    uint8_t          cap;
 } sgl_draw_line_t;
 
 
@@ -437,6 +443,24 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
 void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y1, int16_t y2, uint8_t width, sgl_color_t color, uint8_t alpha);
 
 
+/**
+ * @brief draw a line of any direction with alpha
+ * @param surf surface
+ * @param area area that contains the line
+ * @param x1 line start x position
+ * @param y1 line start y position
+ * @param x2 line end x position
+ * @param y2 line end y position
+ * @param thickness line width
+ * @param cap line cap, SGL_LINE_CAP_ROUND or SGL_LINE_CAP_FLAT
+ * @param color line color
+ * @param alpha alpha of color
+ * @return none
+ * @note only the pixels inside the stroke band of each row are visited
+ */
+void sgl_draw_fill_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, uint8_t cap, sgl_color_t color, uint8_t alpha);
+
+
 /**
  * @brief draw a slanted line with alpha
  * @param surf surface
@@ -449,7 +473,7 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t
  * @param color line color
  * @param alpha alpha of color
  * @return none
- * @note This algorithm is SDF algorithm
+ * @note This draws a line with round caps, see sgl_draw_fill_line
  */
 void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha);
 
@@ -475,6 +499,210 @@ void sgl_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *coords, sgl_d
 void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc);
 
 
+/**
+ * @brief fill a span of pixels with solid color
+ * @param dst point to the first pixel of span
+ * @param color color of span
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_fill(sgl_color_t *dst, sgl_color_t color, uint32_t len);
+
+
+/**
+ * @brief blend a solid color into a span of pixels with constant alpha
+ * @param dst point to the first pixel of span
+ * @param color color of span
+ * @param alpha alpha of color, SGL_ALPHA_MAX means fill
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_blend(sgl_color_t *dst, sgl_color_t color, uint8_t alpha, uint32_t len);
+
+
+/**
+ * @brief blend a solid color into a span of pixels with per-pixel coverage and constant alpha
+ * @param dst point to the first pixel of span
+ * @param color color of span
+ * @param mask coverage of every pixel, 0 means the pixel is not touched, SGL_ALPHA_MAX means solid
+ * @param alpha alpha of color
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_blend_mask(sgl_color_t *dst, sgl_color_t color, const uint8_t *mask, uint8_t alpha, uint32_t len);
+
+
+/**
+ * @brief copy a row of source pixels into a span of pixels with constant alpha
+ * @param dst point to the first pixel of span
+ * @param src point to the first source pixel, it must not overlap with span
+ * @param alpha alpha of source, SGL_ALPHA_MAX means copy
+ * @param len number of pixels
+ * @return none
+ */
+void sgl_span_copy(sgl_color_t *dst, const sgl_color_t *src, uint8_t alpha, uint32_t len);
+
+
+/**
+ * @brief get the half width of a circle row, the pixels in it are nearer to center than radius
+ * @param r2 square of radius
+ * @param y2 square of the distance from row to center
+ * @return the max dx that dx * dx + y2 < r2, -1 if there is no such pixel in row
+ * @note it is used by the scanline primitives to find the edges of row once, instead of testing
+ *       the distance of every pixel
+ */
+static inline int sgl_draw_circle_half(int r2, int y2)
+{
+    return r2 > y2 ? (int)sgl_sqrt((uint32_t)(r2 - y2 - 1)) : -1;
+}
+
+
+/**
+ * @brief blend a solid color into the pixels from x1 to x2 of a row, the pixels out of clip are skipped
+ * @param row point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param x1 first x of span
+ * @param x2 last x of span
+ * @param color color of span
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void sgl_draw_hspan(sgl_color_t *row, sgl_area_t *clip, int x1, int x2, sgl_color_t color, uint8_t alpha)
+{
+    x1 = sgl_max(x1, clip->x1);
+    x2 = sgl_min(x2, clip->x2);
+
+    if (x1 <= x2) {
+        sgl_span_blend(row + (x1 - clip->x1), color, alpha, x2 - x1 + 1);
+    }
+}
+
+
+/**
+ * @brief the parts of a circle or ring row
+ * @half: half widths of hole, inner edge, solid and outer edge, the pixels whose distance to center
+ *        is in (half[i - 1], half[i]] are in part i, -1 means the part does not reach the center
+ * @y2: square of the distance from row to center
+ * @cov: coverage of inner edge pixels from center to outside, followed by the outer edge pixels,
+ *       NULL if the mask is not cached and the coverage is computed by square root error
+ */
+typedef struct sgl_draw_mask_row {
+    int16_t          half[4];
+    int32_t          y2;
+    const uint8_t    *cov;
+} sgl_draw_mask_row_t;
+
+
+/**
+ * @brief the coverage mask of a quarter of circle or ring, it is cached by sgl_draw_mask_get
+ */
+typedef struct sgl_draw_mask sgl_draw_mask_t;
+
+
+/**
+ * @brief get the cached coverage mask of a circle or ring, the mask is built if it is not cached
+ * @param surf surface that the shape is drawn to, the mask is kept in the pool of its band
+ * @param radius outer radius
+ * @param radius_in inner radius of ring, -1 for circle
+ * @return mask, NULL if the cache is disabled or the mask is larger than pool
+ * @note the mask is kept until sgl_draw_mask_put is called, the rows of NULL mask are computed
+ *       by sgl_draw_mask_row directly, so the caller does not need to check it
+ */
+const sgl_draw_mask_t* sgl_draw_mask_get(sgl_surf_t *surf, int16_t radius, int16_t radius_in);
+
+
+/**
+ * @brief give back the mask that is got by sgl_draw_mask_get, then it can be evicted
+ * @param mask mask, it can be NULL
+ * @return none
+ */
+void sgl_draw_mask_put(const sgl_draw_mask_t *mask);
+
+
+/**
+ * @brief free all cached masks that are not used
+ * @param none
+ * @return none
+ * @note it must not be called while the bands are drawn
+ */
+void sgl_draw_mask_clear(void);
+
+
+/**
+ * @brief get a row of circle or ring
+ * @param mask cached mask, NULL to compute the row
+ * @param radius outer radius
+ * @param radius_in inner radius of ring, -1 for circle
+ * @param dy distance from row to center
+ * @param row output row
+ * @return none
+ */
+void sgl_draw_mask_row(const sgl_draw_mask_t *mask, int16_t radius, int16_t radius_in, int dy, sgl_draw_mask_row_t *row);
+
+
+/**
+ * @brief blend the anti-aliasing pixels of an edge part of row on one side of center
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of circle or ring
+ * @param part 1 for inner edge, 3 for outer edge
+ * @param cx x of center
+ * @param dir -1 for the pixels at left of center, 1 for right
+ * @param d1 min distance from pixel to center, the pixels nearer than the edge are skipped
+ * @param d2 max distance from pixel to center, the pixels farther than the edge are skipped
+ * @param color color of shape
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_edge(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int part, int cx, int dir, int d1, int d2, sgl_color_t color, uint8_t alpha);
+
+
+/**
+ * @brief draw a full row of circle or ring, the solid part is drawn as span and the edges by mask
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of circle or ring
+ * @param cx x of center
+ * @param color color of shape
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_hline(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int cx, sgl_color_t color, uint8_t alpha);
+
+
+/**
+ * @brief draw the pixels of a bordered row on one side of center, the hole of ring is the fill, the
+ *        inner edge mixes the border into the fill, the solid part is the border and the outer edge
+ *        mixes the border into the buffer
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of ring whose inner radius is the inner side of border
+ * @param cx x of center
+ * @param dir -1 for the pixels at left of center, 1 for right
+ * @param d1 min distance from pixel to center, the nearer pixels are skipped
+ * @param color color of fill
+ * @param border_color color of border
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_border_side(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int cx, int dir, int d1, sgl_color_t color, sgl_color_t border_color, uint8_t alpha);
+
+
+/**
+ * @brief draw a full bordered row of circle, the fill and the border are drawn as spans and the
+ *        edges by mask
+ * @param buf point to the pixel at clip->x1 of row
+ * @param clip clip area
+ * @param row row of ring whose inner radius is the inner side of border
+ * @param cx x of center
+ * @param color color of fill
+ * @param border_color color of border
+ * @param alpha alpha of shape
+ * @return none
+ */
+void sgl_draw_mask_border_hline(sgl_color_t *buf, sgl_area_t *clip, const sgl_draw_mask_row_t *row, int cx, sgl_color_t color, sgl_color_t border_color, uint8_t alpha);
+
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -94,6 +94,10 @@ typedef struct sgl_event {
 } sgl_event_t;
 
 
+/* the callback that wakes up the thread of sgl task when an event is queued */
+typedef void (*sgl_event_wake_cb_t)(void);
+
+
 /**
  * @brief Initialize the event queue
  * @param none
@@ -107,16 +111,48 @@ int sgl_event_queue_init(void);
 /**
  * @brief Push an event into the event queue
  * @param event The event to be pushed
- * @return 0 on success, -1 on failure
+ * @return none
+ * @note it is safe to push events from input thread or interrupt while sgl_event_task is running,
+ *       the events must be pushed from one context unless CONFIG_SGL_EVENT_QUEUE_MPSC is enabled.
+ *       If the queue is full, the event is dropped and counted by sgl_event_queue_get_overflow
  */
 void sgl_event_queue_push(sgl_event_t event);
 
 
+/**
+ * @brief Get the number of events that are dropped because the event queue is full
+ * @param none
+ * @return The number of dropped events since the queue is initialized
+ */
+uint32_t sgl_event_queue_get_overflow(void);
+
+
+/**
+ * @brief Check whether there are events in the event queue
+ * @param none
+ * @return true if there are events to be handled, false otherwise
+ */
+bool sgl_event_queue_is_pending(void);
+
+
+/**
+ * @brief Set the callback that is called when an event is queued
+ * @param wake_cb The callback, NULL to remove it
+ * @return none
+ * @note the callback is called in the context that sends event, such as input thread or interrupt,
+ *       so it should only wake up the thread of sgl task, for example post a semaphore. It must be
+ *       set before the events are sent
+ */
+void sgl_event_set_wake_cb(sgl_event_wake_cb_t wake_cb);
+
+
 /**
  * @brief Handle the position event
  * @param pos The position to be handled
  * @param type The type of the event
  * @return none
+ * @note the position events must be sent from one context, the motion is merged into the queued
+ *       motion that is not handled yet when CONFIG_SGL_EVENT_MOTION_MERGE is enabled
  */
 void sgl_event_send_pos(sgl_event_pos_t pos, sgl_event_type_t type);
 
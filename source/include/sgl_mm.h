@@ -32,6 +32,18 @@
 extern "C" {
 #endif
 
+/**
+ * @brief  the owner of memory, it is used to attribute memory to modules
+ */
+typedef enum sgl_mm_tag {
+    SGL_MM_TAG_OBJECT = 0,
+    SGL_MM_TAG_FONT,
+    SGL_MM_TAG_IMAGE,
+    SGL_MM_TAG_SCRATCH,
+    SGL_MM_TAG_NUM,
+} sgl_mm_tag_t;
+
+
 /**
  * @brief  memory monitor info
  * @total_size: total size of memory
@@ -40,13 +52,24 @@ extern "C" {
  * @used_rate: used rate of memory:
  *             |  8 bit  |  8 bit |          
  *             |   int   |   dec  |
+ * @peak_size: max used size of memory since startup
+ * @alloc_count: number of live allocations
+ * @max_free_block: size of largest free block, the largest memory that can be allocated at once
+ * @frag_rate: rate of free memory that is not in the largest free block, same format as used_rate
+ * @tag_size: [Optional] used size of memory of every tag, Only present if CONFIG_SGL_MM_TAG is 1.
  */
 typedef struct sgl_mm_monitor {
     size_t  total_size;
     size_t  free_size;
     size_t  used_size;
     size_t  used_rate;
-
+    size_t  peak_size;
+    size_t  alloc_count;
+    size_t  max_free_block;
+    size_t  frag_rate;
+#if (CONFIG_SGL_MM_TAG)
+    size_t  tag_size[SGL_MM_TAG_NUM];
+#endif
 } sgl_mm_monitor_t;
 
 
@@ -105,6 +128,203 @@ void sgl_free(void *p);
 sgl_mm_monitor_t sgl_mm_get_monitor(void);
 
 
+/**
+ * @brief  get used size of memory, it does not walk the heap
+ * 
+ * @param  none
+ * @return used size of memory
+ */
+size_t sgl_mm_get_used_size(void);
+
+
+/**
+ * @brief  get free memory info of heap, it is implemented by heap backend
+ * 
+ * @param  free_size  output, free size of memory
+ * @param  max_free   output, size of largest free block
+ * @return none
+ */
+void sgl_mm_get_free_info(size_t *free_size, size_t *max_free);
+
+
+/**
+ * @brief  account memory pool, it is called by heap backend
+ * 
+ * @param  len  length of memory pool
+ * @return none
+ */
+void sgl_mm_stat_add_pool(size_t len);
+
+
+/**
+ * @brief  account allocated block, it is called by heap backend
+ * 
+ * @param  size  size of block
+ * @return none
+ */
+void sgl_mm_stat_alloc(size_t size);
+
+
+/**
+ * @brief  account freed block, it is called by heap backend
+ * 
+ * @param  size  size of block, it must be same as the size when it is allocated
+ * @return none
+ */
+void sgl_mm_stat_free(size_t size);
+
+
+#if (CONFIG_SGL_MM_TAG)
+/**
+ * @brief  memory alloc with tag, the size of block is attributed to the tag
+ * 
+ * @param  size   request size of memory
+ * @param  tag    the owner of memory
+ * 
+ * @return point to request memory address
+*/
+void* sgl_malloc_tagged(size_t size, sgl_mm_tag_t tag);
+
+
+/**
+ * @brief  memory free with tag, the memory must be allocated by sgl_malloc_tagged with same tag
+ * 
+ * @param  p      the pointer of request size of memory
+ * @param  tag    the owner of memory
+ * 
+ * @return none
+*/
+void sgl_free_tagged(void *p, sgl_mm_tag_t tag);
+#else
+static inline void* sgl_malloc_tagged(size_t size, sgl_mm_tag_t tag)
+{
+    SGL_UNUSED(tag);
+    return sgl_malloc(size);
+}
+
+static inline void sgl_free_tagged(void *p, sgl_mm_tag_t tag)
+{
+    SGL_UNUSED(tag);
+    sgl_free(p);
+}
+#endif
+
+
+/* the objects are allocated from the slots of size classes */
+#define  SGL_SLAB_ENABLE    (CONFIG_SGL_OBJ_SLOT_DYNAMIC || CONFIG_SGL_OBJ_NUM_MAX)
+
+#if (SGL_SLAB_ENABLE)
+/**
+ * @brief  alloc memory of object from the slots of size classes
+ * 
+ * @param  size   size of object
+ * 
+ * @return point to object memory, all bytes are zero, NULL if no memory
+ * @note   the objects that are freed by sgl_obj_free must be allocated by this function
+*/
+void* sgl_slab_alloc(size_t size);
+
+
+/**
+ * @brief  free memory of object that is allocated by sgl_slab_alloc
+ * 
+ * @param  p  point to object memory
+ * 
+ * @return none
+ * @note   the object that is allocated by sgl_malloc, such as a widget of application, is detected
+ *         and freed by sgl_free
+*/
+void sgl_slab_free(void *p);
+
+
+/**
+ * @brief  get the bytes of free slots that are allocated from heap
+ * 
+ * @param  none
+ * 
+ * @return bytes of free slots, they are counted in the used size of heap
+*/
+size_t sgl_slab_get_free_size(void);
+#else
+static inline void* sgl_slab_alloc(size_t size)
+{
+    return sgl_malloc_tagged(size, SGL_MM_TAG_OBJECT);
+}
+
+static inline void sgl_slab_free(void *p)
+{
+    sgl_free_tagged(p, SGL_MM_TAG_OBJECT);
+}
+
+static inline size_t sgl_slab_get_free_size(void)
+{
+    return 0;
+}
+#endif
+
+
+#if (CONFIG_SGL_SCRATCH_SIZE)
+/**
+ * @brief  alloc transient memory of drawing from scratch arena
+ * 
+ * @param  size   request size of memory
+ * 
+ * @return point to memory, NULL if no memory
+ * @note   the memory is valid until the end of current frame, it should be given back by sgl_scratch_free
+*/
+void* sgl_scratch_alloc(size_t size);
+
+
+/**
+ * @brief  give back transient memory that is allocated by sgl_scratch_alloc
+ * 
+ * @param  p  point to memory
+ * 
+ * @return none
+*/
+void sgl_scratch_free(void *p);
+
+
+/**
+ * @brief  reset scratch arena, it is called at the end of every frame
+ * 
+ * @param  none
+ * 
+ * @return none
+*/
+void sgl_scratch_reset(void);
+
+
+/**
+ * @brief  get the high water mark of scratch arena
+ * 
+ * @param  none
+ * 
+ * @return the max used bytes of scratch arena since startup
+*/
+size_t sgl_scratch_get_peak(void);
+#else
+static inline void* sgl_scratch_alloc(size_t size)
+{
+    return sgl_malloc_tagged(size, SGL_MM_TAG_SCRATCH);
+}
+
+static inline void sgl_scratch_free(void *p)
+{
+    sgl_free_tagged(p, SGL_MM_TAG_SCRATCH);
+}
+
+static inline void sgl_scratch_reset(void)
+{
+}
+
+static inline size_t sgl_scratch_get_peak(void)
+{
+    return 0;
+}
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
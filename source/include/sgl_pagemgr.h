@@ -0,0 +1,108 @@
+/* source/include/sgl_pagemgr.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_PAGEMGR_H__
+#define __SGL_PAGEMGR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <sgl_cfgfix.h>
+#include <sgl_core.h>
+
+
+#if (CONFIG_SGL_PAGEMGR_NUM)
+
+/**
+ * @brief The callbacks of page that is managed by page manager
+ *
+ * @build:   create all the widgets of page, it is called when the page is loaded and not resident.
+ *           The page object is created by page manager and passed as parent of widgets.
+ *
+ * @save:    optional, it is called before the page is evicted, the application can keep the
+ *           state of widgets, such as the value of slider or text of textline, in user_data.
+ *
+ * @restore: optional, it is called after the evicted page is built again, the application can
+ *           set the state of widgets that is kept by save callback.
+ */
+typedef struct sgl_page_ops {
+    void (*build)(sgl_obj_t *page, void *user_data);
+    void (*save)(sgl_obj_t *page, void *user_data);
+    void (*restore)(sgl_obj_t *page, void *user_data);
+} sgl_page_ops_t;
+
+
+/**
+ * @brief register a page into page manager, the page is not built until it is loaded
+ * @param ops: callbacks of page, it must be kept valid by application
+ * @param user_data: user data that is passed to callbacks
+ * @return id of page, -1 if there is no free slot
+ */
+int sgl_pagemgr_register(const sgl_page_ops_t *ops, void *user_data);
+
+
+/**
+ * @brief load a page as active screen, the page is built if it is not resident
+ * @param id: id of page
+ * @return page object, NULL if the page can not be built
+ * @note the pages that are not used for the longest time are evicted while the used memory is
+ *       larger than budget, the active page is never evicted
+ */
+sgl_obj_t* sgl_pagemgr_load(int id);
+
+
+/**
+ * @brief get the page object of id
+ * @param id: id of page
+ * @return page object, NULL if the page is not resident
+ */
+sgl_obj_t* sgl_pagemgr_get(int id);
+
+
+/**
+ * @brief evict a page, its state is saved and all its objects are freed
+ * @param id: id of page
+ * @return none
+ * @note the active page can not be evicted, the managed pages must not be deleted by sgl_obj_delete
+ */
+void sgl_pagemgr_evict(int id);
+
+
+/**
+ * @brief set memory budget of page manager
+ * @param budget: max used size of memory in bytes, 0 means the pages are never evicted by budget
+ * @return none
+ */
+void sgl_pagemgr_set_budget(size_t budget);
+
+#endif // ! CONFIG_SGL_PAGEMGR_NUM
+
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // ! __SGL_PAGEMGR_H__
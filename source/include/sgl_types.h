@@ -31,6 +31,27 @@
 #include <sgl_cfgfix.h>
 
 
+/**
+ * The counters that are shared with interrupt or another thread use C11 atomics when the compiler
+ * supports them, otherwise they are volatile, that is only safe on single core MCU. C++ sees the
+ * volatile type, it has the same size and layout as atomic_uint.
+ */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__) && !defined(__cplusplus)
+#include <stdatomic.h>
+#define  SGL_ATOMIC_C11                         (1)
+typedef atomic_uint                             sgl_atomic_uint_t;
+#define sgl_atomic_load(p, order)               atomic_load_explicit(p, memory_order_##order)
+#define sgl_atomic_store(p, v, order)           atomic_store_explicit(p, v, memory_order_##order)
+#define sgl_atomic_inc(p, order)                atomic_fetch_add_explicit(p, 1, memory_order_##order)
+#else
+#define  SGL_ATOMIC_C11                         (0)
+typedef volatile unsigned int                   sgl_atomic_uint_t;
+#define sgl_atomic_load(p, order)               (*(p))
+#define sgl_atomic_store(p, v, order)           (*(p) = (v))
+#define sgl_atomic_inc(p, order)                ((*(p))++)
+#endif
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -72,7 +93,7 @@ extern "C" {
 #define SGL_POS_INVALID                         (0xefff)
 #define SGL_POS_MAX                             (8192)
 #define SGL_POS_MIN                             (-8192)
-#define SGL_RADIUS_INVALID                      (0xFFF)
+#define SGL_RADIUS_INVALID                      (0x3FF)
 
 #define SGL_AREA_MAX                            {.x1 = SGL_POS_MIN, .y1 = SGL_POS_MIN, .x2 = SGL_POS_MAX, .y2 = SGL_POS_MAX}
 #define SGL_AREA_INVALID                        {.x1 = SGL_POS_MAX, .y1 = SGL_POS_MAX, .x2 = SGL_POS_MIN, .y2 = SGL_POS_MIN}
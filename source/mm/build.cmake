@@ -21,6 +21,13 @@
 # SOFTWARE.
 #
 
+set(SGL_SOURCE
+    ${SGL_SOURCE}
+    ${CMAKE_CURRENT_LIST_DIR}/stat/sgl_mm_stat.c
+    ${CMAKE_CURRENT_LIST_DIR}/slab/sgl_slab.c
+    ${CMAKE_CURRENT_LIST_DIR}/scratch/sgl_scratch.c
+)
+
 if(${SGL_HEAP_ALGO} STREQUAL "tlsf")
     set(SGL_SOURCE
         ${SGL_SOURCE}
@@ -34,13 +34,8 @@
 #include <string.h>
 
 
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
-
 static void *bump_mem_start = NULL;
+static size_t bump_mem_size = 0;
 static size_t bump_mem_offset = 0;
 
 /**
@@ -51,8 +46,8 @@ static size_t bump_mem_offset = 0;
 void sgl_mm_init(void *mem_start, size_t len)
 {
     bump_mem_start = mem_start;
-    mem.total_size += len;
-    mem.free_size = mem.total_size;
+    bump_mem_size = len;
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -82,14 +77,13 @@ void* sgl_malloc(size_t size)
 {
     uint8_t *ptr = (uint8_t*)bump_mem_start;
 
-    if (size == 0 || (bump_mem_offset + size) > mem.total_size) {
+    if (size == 0 || (bump_mem_offset + size) > bump_mem_size) {
         return NULL;
     }
 
     ptr += bump_mem_offset;
     bump_mem_offset += size;
-    mem.used_size += size;
-    mem.free_size -= size;
+    sgl_mm_stat_alloc(size);
 
     return (void*)ptr;
 }
@@ -126,12 +120,15 @@ void sgl_free(void *p)
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+/**
+ * @brief  get free memory info of heap
+ * @param  free_size  output, free size of memory
+ * @param  max_free   output, size of largest free block
+ * @return none
+ * @note   the free memory is always contiguous
+ */
+void sgl_mm_get_free_info(size_t *free_size, size_t *max_free)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
-
-    return mem;
+    *free_size = bump_mem_size - bump_mem_offset;
+    *max_free = *free_size;
 }
@@ -1138,6 +1138,35 @@ lwmem_get_size_ex(lwmem_t* lwobj, void* ptr) {
     return len;
 }
 
+/**
+ * \brief           Get free memory of a LwMEM instance by walking the free list
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ * \param[out]      free_size: Total free size for user in units of bytes
+ * \param[out]      max_free: Size of the largest free block for user in units of bytes
+ */
+void
+lwmem_get_free_info_ex(lwmem_t* lwobj, size_t* free_size, size_t* max_free) {
+    lwmem_block_t* block;
+    size_t size, total = 0, max = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (block = lwobj->start_block.next; block != NULL; block = block->next) {
+        /* End of region blocks have no free memory */
+        if (block->size <= LWMEM_BLOCK_META_SIZE) {
+            continue;
+        }
+        size = block->size - LWMEM_BLOCK_META_SIZE;
+        total += size;
+        if (size > max) {
+            max = size;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    *free_size = total;
+    *max_free = max;
+}
+
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 #if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
@@ -1282,6 +1311,17 @@ lwmem_get_size(void* ptr) {
     return lwmem_get_size_ex(NULL, ptr);
 }
 
+/**
+ * \note            This is a wrapper for \ref lwmem_get_free_info_ex function.
+ *                      It operates in default LwMEM instance
+ * \param[out]      free_size: Total free size for user in units of bytes
+ * \param[out]      max_free: Size of the largest free block for user in units of bytes
+ */
+void
+lwmem_get_free_info(size_t* free_size, size_t* max_free) {
+    lwmem_get_free_info_ex(NULL, free_size, max_free);
+}
+
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 /* Part of library used ONLY for LWMEM_DEV purposes */
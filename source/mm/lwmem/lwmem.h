@@ -122,6 +122,7 @@ int lwmem_realloc_s_ex(lwmem_t* lwobj, const lwmem_region_t* region, void** cons
 void lwmem_free_ex(lwmem_t* lwobj, void* const ptr);
 void lwmem_free_s_ex(lwmem_t* lwobj, void** const ptr);
 size_t lwmem_get_size_ex(lwmem_t* lwobj, void* ptr);
+void lwmem_get_free_info_ex(lwmem_t* lwobj, size_t* free_size, size_t* max_free);
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 #if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
 void lwmem_get_stats_ex(lwmem_t* lwobj, lwmem_stats_t* stats);
@@ -138,6 +139,7 @@ int lwmem_realloc_s(void** ptr2ptr, size_t size);
 void lwmem_free(void* ptr);
 void lwmem_free_s(void** ptr2ptr);
 size_t lwmem_get_size(void* ptr);
+void lwmem_get_free_info(size_t* free_size, size_t* max_free);
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 #if defined(LWMEM_DEV) && !__DOXYGEN__
@@ -29,13 +29,6 @@
 #include <sgl_cfgfix.h>
 
 
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
-
-
 /**
  * @brief  initialize memory pool
  * @param  mem_start  start address of memory pool
@@ -49,7 +42,7 @@ void sgl_mm_init(void *mem_start, size_t len)
     };
 
     lwmem_assignmem(lwmem);
-    mem.total_size += len;
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -66,7 +59,7 @@ void sgl_mm_add_pool(void *mem_start, size_t len)
     };
 
     lwmem_assignmem(lwmem);
-    mem.total_size += len;
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -86,7 +79,7 @@ void* sgl_malloc(size_t size)
         return NULL;
     }
 
-    mem.used_size += lwmem_get_size(ret);
+    sgl_mm_stat_alloc(lwmem_get_size(ret));
 
     return ret;
 }
@@ -100,13 +93,22 @@ void* sgl_malloc(size_t size)
  */
 void* sgl_realloc(void *p, size_t size)
 {
+    size_t old_size = lwmem_get_size(p);
     void *ret = lwmem_realloc(p, size);
+
+    /* the block is freed if size is 0 */
+    if (p != NULL && (ret != NULL || size == 0)) {
+        sgl_mm_stat_free(old_size);
+    }
+
     if(ret == NULL) {
-        SGL_LOG_ERROR("out of memory");
+        if (size != 0) {
+            SGL_LOG_ERROR("out of memory");
+        }
         return NULL;
     }
 
-    mem.used_size += size;
+    sgl_mm_stat_alloc(lwmem_get_size(ret));
 
     return ret;
 }
@@ -121,17 +123,22 @@ void* sgl_realloc(void *p, size_t size)
 */
 void sgl_free(void *p)
 {
-    mem.used_size -= lwmem_get_size(p);
+    if (p == NULL) {
+        return;
+    }
+
+    sgl_mm_stat_free(lwmem_get_size(p));
     lwmem_free(p);
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+/**
+ * @brief  get free memory info of heap
+ * @param  free_size  output, free size of memory
+ * @param  max_free   output, size of largest free block
+ * @return none
+ */
+void sgl_mm_get_free_info(size_t *free_size, size_t *max_free)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
-    
-    return mem;
+    lwmem_get_free_info(free_size, max_free);
 }
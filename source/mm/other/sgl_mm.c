@@ -37,14 +37,22 @@
  * 3. Your implementation will automatically override these defaults
  * 
  * Functions available for override:
- *   - void* sgl_mm_alloc(size_t size)
- *   - void  sgl_mm_free(void *ptr)
- *   - void* sgl_mm_realloc(void *ptr, size_t size)
+ *   - void* sgl_malloc(size_t size)
+ *   - void  sgl_free(void *ptr)
+ *   - void* sgl_realloc(void *ptr, size_t size)
+ *   - void  sgl_mm_get_free_info(size_t *free_size, size_t *max_free)
+ * 
+ * The defaults are plain system blocks without a private header, so each of
+ * them can be overridden alone. The overrides should report the size of blocks
+ * by sgl_mm_stat_alloc() and sgl_mm_stat_free(), so that sgl_mm_get_monitor()
+ * is still accurate.
  * 
  * Example (in your application code):
  * @code
- *   void* sgl_mm_alloc(size_t size) {
- *       return my_custom_allocator(size);
+ *   void* sgl_malloc(size_t size) {
+ *       void *p = my_custom_allocator(size);
+ *       sgl_mm_stat_alloc(my_custom_block_size(p));
+ *       return p;
  *   }
  * @endcode
  */
@@ -58,11 +66,28 @@
 #include <string.h>
 
 
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
+/**
+ * the size of block is asked from system heap instead of a private header, so the blocks of every
+ * function are plain system blocks, and any of them can be overridden alone
+ */
+#if defined(__GLIBC__) || defined(__NEWLIB__) || defined(__ANDROID__)
+#include <malloc.h>
+#define  sgl_mm_block_size(p)    malloc_usable_size(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define  sgl_mm_block_size(p)    malloc_size(p)
+#elif defined(_WIN32)
+#include <malloc.h>
+#define  sgl_mm_block_size(p)    _msize(p)
+#else
+/* the size of block is unknown, so the used memory is not accounted */
+#define  sgl_mm_block_size(p)    ((size_t)0)
+#endif
+
+
+/* the size of pools and used memory, the free memory is the difference of them */
+static size_t mem_total = 0;
+static size_t mem_used = 0;
 
 
 /**
@@ -72,7 +97,9 @@ static sgl_mm_monitor_t mem = {
  */
 void sgl_mm_init(void *mem_start, size_t len)
 {
-    mem.total_size += len;
+    SGL_UNUSED(mem_start);
+    mem_total += len;
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -83,8 +110,9 @@ void sgl_mm_init(void *mem_start, size_t len)
  */
 void sgl_mm_add_pool(void *mem_start, size_t len)
 {
-    
-    mem.total_size += len;
+    SGL_UNUSED(mem_start);
+    mem_total += len;
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -99,6 +127,17 @@ void sgl_mm_add_pool(void *mem_start, size_t len)
 sgl_weak_fn void* sgl_malloc(size_t size)
 {
     void *p = malloc(size);
+    size_t block = 0;
+
+    if (p == NULL) {
+        SGL_LOG_ERROR("out of memory");
+        return NULL;
+    }
+
+    block = sgl_mm_block_size(p);
+    mem_used += block;
+    sgl_mm_stat_alloc(block);
+
     memset(p, 0, size);
     return p;
 }
@@ -112,7 +151,29 @@ sgl_weak_fn void* sgl_malloc(size_t size)
  */
 sgl_weak_fn void* sgl_realloc(void *p, size_t size)
 {
-    return realloc(p, size);
+    size_t old_block = 0, block = 0;
+
+    if (p == NULL) {
+        return sgl_malloc(size);
+    }
+    else if (size == 0) {
+        sgl_free(p);
+        return NULL;
+    }
+
+    old_block = sgl_mm_block_size(p);
+    p = realloc(p, size);
+    if (p == NULL) {
+        SGL_LOG_ERROR("out of memory");
+        return NULL;
+    }
+
+    block = sgl_mm_block_size(p);
+    mem_used = mem_used - old_block + block;
+    sgl_mm_stat_free(old_block);
+    sgl_mm_stat_alloc(block);
+
+    return p;
 }
 
 
@@ -125,17 +186,28 @@ sgl_weak_fn void* sgl_realloc(void *p, size_t size)
 */
 sgl_weak_fn void sgl_free(void *p)
 {
-    //mem.used_size -= ;
+    size_t block = 0;
+
+    if (p == NULL) {
+        return;
+    }
+
+    block = sgl_mm_block_size(p);
+    mem_used -= block;
+    sgl_mm_stat_free(block);
     free(p);
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+/**
+ * @brief  get free memory info of heap
+ * @param  free_size  output, free size of memory
+ * @param  max_free   output, size of largest free block
+ * @return none
+ * @note   the blocks of system heap are unknown, so the free memory is treated as one block
+ */
+sgl_weak_fn void sgl_mm_get_free_info(size_t *free_size, size_t *max_free)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
-
-    return mem;
+    *free_size = mem_total > mem_used ? mem_total - mem_used : 0;
+    *max_free = *free_size;
 }
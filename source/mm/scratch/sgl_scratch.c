@@ -0,0 +1,153 @@
+/* source/mm/scratch/sgl_scratch.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * The scratch arena is a bump allocator for the transient buffers of drawing, the buffers are
+ * only valid in current frame, and the arena is reset after the frame is drawn, so the draw path
+ * does not touch the heap. If the arena is full, the buffer is allocated from heap, so please
+ * check the high water mark to find the right arena size.
+ */
+
+#include <stdint.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+#include <pthread.h>
+#endif
+
+
+#if (CONFIG_SGL_SCRATCH_SIZE)
+
+static struct sgl_scratch {
+    size_t           pool[CONFIG_SGL_SCRATCH_SIZE / sizeof(size_t)];
+    size_t           ofs;
+    size_t           last;
+    size_t           peak;
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+    /* the bands of slice are drawn in parallel */
+    pthread_mutex_t  lock;
+#endif
+} sgl_scratch = {
+    .ofs = 0,
+    .last = SIZE_MAX,
+    .peak = 0,
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+#endif
+};
+
+
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+#define  sgl_scratch_lock()        pthread_mutex_lock(&sgl_scratch.lock)
+#define  sgl_scratch_unlock()      pthread_mutex_unlock(&sgl_scratch.lock)
+#else
+#define  sgl_scratch_lock()        do {} while (0)
+#define  sgl_scratch_unlock()      do {} while (0)
+#endif
+
+
+/**
+ * @brief alloc transient memory from scratch arena
+ * @param size: request size of memory
+ * @return point to memory, NULL if no memory
+ * @note the memory is valid until the end of current frame, it should be given back by sgl_scratch_free
+ */
+void* sgl_scratch_alloc(size_t size)
+{
+    uint8_t *p = NULL;
+
+    size = SGL_ALIGN_UP(size, sizeof(size_t));
+
+    sgl_scratch_lock();
+    if (size > 0 && size <= sizeof(sgl_scratch.pool) - sgl_scratch.ofs) {
+        p = (uint8_t*)sgl_scratch.pool + sgl_scratch.ofs;
+        sgl_scratch.last = sgl_scratch.ofs;
+        sgl_scratch.ofs += size;
+        sgl_scratch.peak = sgl_max(sgl_scratch.peak, sgl_scratch.ofs);
+    }
+    sgl_scratch_unlock();
+
+    if (p == NULL) {
+        SGL_LOG_WARN("sgl_scratch_alloc: scratch arena is full, request %d bytes", (int)size);
+        p = (uint8_t*)sgl_malloc_tagged(size, SGL_MM_TAG_SCRATCH);
+    }
+
+    return p;
+}
+
+
+/**
+ * @brief release transient memory before the end of frame
+ * @param p: point to memory that is allocated by sgl_scratch_alloc
+ * @return none
+ * @note only the last allocation is given back at once, the others are released at the end of frame
+ */
+void sgl_scratch_free(void *p)
+{
+    uint8_t *base = (uint8_t*)sgl_scratch.pool;
+
+    if (p == NULL) {
+        return;
+    }
+
+    /* the memory is allocated from heap when the arena is full */
+    if ((uint8_t*)p < base || (uint8_t*)p >= base + sizeof(sgl_scratch.pool)) {
+        sgl_free_tagged(p, SGL_MM_TAG_SCRATCH);
+        return;
+    }
+
+    sgl_scratch_lock();
+    if ((size_t)((uint8_t*)p - base) == sgl_scratch.last) {
+        sgl_scratch.ofs = sgl_scratch.last;
+        sgl_scratch.last = SIZE_MAX;
+    }
+    sgl_scratch_unlock();
+}
+
+
+/**
+ * @brief reset scratch arena, all transient memory is released
+ * @param none
+ * @return none
+ * @note it is called at the end of every frame
+ */
+void sgl_scratch_reset(void)
+{
+    sgl_scratch.ofs = 0;
+    sgl_scratch.last = SIZE_MAX;
+}
+
+
+/**
+ * @brief get the high water mark of scratch arena
+ * @param none
+ * @return the max used bytes of scratch arena since startup
+ */
+size_t sgl_scratch_get_peak(void)
+{
+    return sgl_scratch.peak;
+}
+
+#endif // !CONFIG_SGL_SCRATCH_SIZE
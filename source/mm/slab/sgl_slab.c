@@ -0,0 +1,203 @@
+/* source/mm/slab/sgl_slab.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * The object slots are kept in per size class free lists in front of the heap. A freed slot is
+ * only reused by the objects of the same class, so creating and destroying pages does not split
+ * the heap. Every slot starts with one word header, it holds the class of slot when the slot is
+ * used, and the next free slot when the slot is free. The class is keyed by the address of slot,
+ * so a pointer that is not allocated here is detected and given back to heap.
+ */
+
+#include <stdint.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+#include <string.h>
+
+
+#if (SGL_SLAB_ENABLE)
+
+/* the payload size of class, the widgets are object with a few members */
+#define  SGL_SLAB_SIZE(ext)        SGL_ALIGN_UP(sizeof(sgl_obj_t) + (ext) * sizeof(void*), sizeof(size_t))
+#define  SGL_SLAB_CLASS_NUM        (5)
+#define  SGL_SLAB_SLOT_MAX         (sizeof(sgl_slab_slot_t) + SGL_SLAB_SIZE(12))
+
+/* the tag of slot that is allocated from heap, it is larger than any class */
+#define  SGL_SLAB_MAGIC            ((size_t)0x5a5a0000)
+#define  SGL_SLAB_HEAP             (SGL_SLAB_CLASS_NUM)
+#define  SGL_SLAB_TAG(slot, cls)   (((size_t)(uintptr_t)(slot) ^ SGL_SLAB_MAGIC) + (size_t)(cls))
+
+/* the number of slots that are allocated from heap at once */
+#define  SGL_SLAB_CHUNK_SLOTS      (4)
+
+
+typedef union sgl_slab_slot {
+    union sgl_slab_slot *next;
+    size_t              tag;
+} sgl_slab_slot_t;
+
+
+static const uint16_t slab_size[SGL_SLAB_CLASS_NUM] = {
+    SGL_SLAB_SIZE(1), SGL_SLAB_SIZE(3), SGL_SLAB_SIZE(5), SGL_SLAB_SIZE(8), SGL_SLAB_SIZE(12),
+};
+
+static sgl_slab_slot_t *slab_free[SGL_SLAB_CLASS_NUM];
+
+/* the bytes of free slots that are allocated from heap */
+static size_t slab_free_size = 0;
+
+
+#if (!CONFIG_SGL_OBJ_SLOT_DYNAMIC)
+/* the static slot pool, it can hold CONFIG_SGL_OBJ_NUM_MAX objects of largest class at least */
+static size_t slab_pool[CONFIG_SGL_OBJ_NUM_MAX * SGL_SLAB_SLOT_MAX / sizeof(size_t)];
+static size_t slab_pool_ofs = 0;
+#endif
+
+
+/**
+ * @brief add new slots into the free list of class
+ * @param cls: class of slot
+ * @return true if the slots are added, otherwise false
+ */
+static bool slab_refill(int cls)
+{
+    size_t slot_size = sizeof(sgl_slab_slot_t) + slab_size[cls];
+    sgl_slab_slot_t *slot = NULL;
+    uint8_t *chunk = NULL;
+    int num = 0;
+
+#if (CONFIG_SGL_OBJ_SLOT_DYNAMIC)
+    chunk = (uint8_t*)sgl_malloc_tagged(slot_size * SGL_SLAB_CHUNK_SLOTS, SGL_MM_TAG_OBJECT);
+    if (chunk == NULL) {
+        return false;
+    }
+    num = SGL_SLAB_CHUNK_SLOTS;
+    slab_free_size += slot_size * num;
+#else
+    if (slab_pool_ofs + slot_size > sizeof(slab_pool)) {
+        return false;
+    }
+    chunk = (uint8_t*)slab_pool + slab_pool_ofs;
+    slab_pool_ofs += slot_size;
+    num = 1;
+#endif
+
+    for (int i = 0; i < num; i++) {
+        slot = (sgl_slab_slot_t*)(chunk + i * slot_size);
+        slot->next = slab_free[cls];
+        slab_free[cls] = slot;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief alloc memory of object from the slots
+ * @param size: size of object
+ * @return pointer of object, all bytes are zero, NULL if no memory
+ * @note the object that is larger than all classes is allocated from heap
+ */
+void* sgl_slab_alloc(size_t size)
+{
+    sgl_slab_slot_t *slot = NULL;
+    int cls = 0;
+
+    while (cls < SGL_SLAB_CLASS_NUM && slab_size[cls] < size) {
+        cls ++;
+    }
+
+    /* if the class has no free slot, the free slots of larger classes are used */
+    for (int i = cls; i < SGL_SLAB_CLASS_NUM; i++) {
+        if (slab_free[i] != NULL || slab_refill(i)) {
+            slot = slab_free[i];
+            slab_free[i] = slot->next;
+#if (CONFIG_SGL_OBJ_SLOT_DYNAMIC)
+            slab_free_size -= sizeof(sgl_slab_slot_t) + slab_size[i];
+#endif
+            slot->tag = SGL_SLAB_TAG(slot, i);
+            memset(slot + 1, 0, slab_size[i]);
+            return slot + 1;
+        }
+    }
+
+    if (cls < SGL_SLAB_CLASS_NUM) {
+        SGL_LOG_WARN("sgl_slab_alloc: no free slot, alloc from heap");
+    }
+
+    slot = (sgl_slab_slot_t*)sgl_malloc_tagged(sizeof(sgl_slab_slot_t) + size, SGL_MM_TAG_OBJECT);
+    if (slot == NULL) {
+        return NULL;
+    }
+
+    slot->tag = SGL_SLAB_TAG(slot, SGL_SLAB_HEAP);
+    memset(slot + 1, 0, size);
+    return slot + 1;
+}
+
+
+/**
+ * @brief free memory of object that is allocated by sgl_slab_alloc
+ * @param p: pointer of object
+ * @return none
+ * @note the object that is allocated by sgl_malloc is given back to heap, the word in front of it
+ *       is read, so it must be a heap block
+ */
+void sgl_slab_free(void *p)
+{
+    sgl_slab_slot_t *slot = (sgl_slab_slot_t*)p - 1;
+    size_t cls = slot->tag - SGL_SLAB_TAG(slot, 0);
+
+    /* the header of heap block hardly matches the tag that is keyed by address */
+    if (unlikely(cls > SGL_SLAB_HEAP)) {
+        SGL_LOG_TRACE("sgl_slab_free: not a slot, free to heap");
+        sgl_free(p);
+        return;
+    }
+
+    if (cls == SGL_SLAB_HEAP) {
+        sgl_free_tagged(slot, SGL_MM_TAG_OBJECT);
+        return;
+    }
+
+    slot->next = slab_free[cls];
+    slab_free[cls] = slot;
+#if (CONFIG_SGL_OBJ_SLOT_DYNAMIC)
+    slab_free_size += sizeof(sgl_slab_slot_t) + slab_size[cls];
+#endif
+}
+
+
+/**
+ * @brief get the bytes of free slots that are allocated from heap
+ * @param none
+ * @return bytes of free slots, the static slots are not counted because they are not in heap
+ */
+size_t sgl_slab_get_free_size(void)
+{
+    return slab_free_size;
+}
+
+#endif // !SGL_SLAB_ENABLE
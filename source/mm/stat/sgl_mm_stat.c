@@ -0,0 +1,195 @@
+/* source/mm/stat/sgl_mm_stat.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * The memory accounting that is shared by all heap backends, the backend reports the size of every
+ * block that is allocated or freed, and the free blocks of heap when the monitor is read.
+ */
+
+#include <stdint.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+
+
+static struct sgl_mm_stat {
+    size_t  total_size;
+    size_t  used_size;
+    size_t  peak_size;
+    size_t  alloc_count;
+#if (CONFIG_SGL_MM_TAG)
+    size_t  tag_size[SGL_MM_TAG_NUM];
+#endif
+} sgl_mm_stat = {
+    .total_size = 0,
+    .used_size = 0,
+    .peak_size = 0,
+    .alloc_count = 0,
+};
+
+
+/**
+ * @brief  account memory pool that is added into heap
+ * @param  len  length of memory pool
+ * @return none
+ */
+void sgl_mm_stat_add_pool(size_t len)
+{
+    sgl_mm_stat.total_size += len;
+}
+
+
+/**
+ * @brief  account block that is allocated from heap
+ * @param  size  size of block
+ * @return none
+ */
+void sgl_mm_stat_alloc(size_t size)
+{
+    sgl_mm_stat.used_size += size;
+    sgl_mm_stat.alloc_count ++;
+    sgl_mm_stat.peak_size = sgl_max(sgl_mm_stat.peak_size, sgl_mm_stat.used_size);
+}
+
+
+/**
+ * @brief  account block that is freed into heap
+ * @param  size  size of block
+ * @return none
+ */
+void sgl_mm_stat_free(size_t size)
+{
+    SGL_ASSERT(sgl_mm_stat.used_size >= size && sgl_mm_stat.alloc_count > 0);
+
+    sgl_mm_stat.used_size -= size;
+    sgl_mm_stat.alloc_count --;
+}
+
+
+/**
+ * @brief  get the rate of part in total
+ * @param  part  part size
+ * @param  total total size
+ * @return rate, |  8 bit  |  8 bit |
+ *               |   int   |   dec  |
+ */
+static size_t sgl_mm_rate(size_t part, size_t total)
+{
+    int integer, decimal;
+
+    if (total == 0) {
+        return 0;
+    }
+
+    integer = (int)((uint64_t)part * 100 / total);
+    decimal = (int)((uint64_t)part * 10000 / total) - (integer * 100);
+
+    return integer << 8 | decimal;
+}
+
+
+/**
+ * @brief  get memory monitor info
+ *
+ * @param  none
+ * @return memory monitor info
+ */
+sgl_mm_monitor_t sgl_mm_get_monitor(void)
+{
+    sgl_mm_monitor_t mem = {
+        .total_size = sgl_mm_stat.total_size,
+        .used_size = sgl_mm_stat.used_size,
+        .peak_size = sgl_mm_stat.peak_size,
+        .alloc_count = sgl_mm_stat.alloc_count,
+    };
+
+    sgl_mm_get_free_info(&mem.free_size, &mem.max_free_block);
+
+    mem.used_rate = sgl_mm_rate(mem.used_size, mem.total_size);
+    /* the free memory that can not be allocated in one block */
+    mem.frag_rate = sgl_mm_rate(mem.free_size - mem.max_free_block, mem.free_size);
+
+#if (CONFIG_SGL_MM_TAG)
+    for (int i = 0; i < SGL_MM_TAG_NUM; i++) {
+        mem.tag_size[i] = sgl_mm_stat.tag_size[i];
+    }
+#endif
+
+    return mem;
+}
+
+
+/**
+ * @brief  get used size of memory, it does not walk the heap
+ *
+ * @param  none
+ * @return used size of memory
+ */
+size_t sgl_mm_get_used_size(void)
+{
+    return sgl_mm_stat.used_size;
+}
+
+
+#if (CONFIG_SGL_MM_TAG)
+/**
+ * @brief  memory alloc with tag, the size of block is attributed to the tag
+ *
+ * @param  size   request size of memory
+ * @param  tag    the owner of memory
+ *
+ * @return point to request memory address
+*/
+void* sgl_malloc_tagged(size_t size, sgl_mm_tag_t tag)
+{
+    size_t used = sgl_mm_stat.used_size;
+    void *p = sgl_malloc(size);
+
+    SGL_ASSERT(tag < SGL_MM_TAG_NUM);
+
+    /* the backend has accounted the real size of block */
+    sgl_mm_stat.tag_size[tag] += sgl_mm_stat.used_size - used;
+
+    return p;
+}
+
+
+/**
+ * @brief  memory free with tag, the memory must be allocated by sgl_malloc_tagged with same tag
+ *
+ * @param  p      the pointer of request size of memory
+ * @param  tag    the owner of memory
+ *
+ * @return none
+*/
+void sgl_free_tagged(void *p, sgl_mm_tag_t tag)
+{
+    size_t used = sgl_mm_stat.used_size;
+
+    SGL_ASSERT(tag < SGL_MM_TAG_NUM);
+
+    sgl_free(p);
+    sgl_mm_stat.tag_size[tag] -= used - sgl_mm_stat.used_size;
+}
+#endif
@@ -29,12 +29,13 @@
 #include <sgl_cfgfix.h>
 
 
+/* the pools of heap, they are walked to find the free blocks */
+#define  SGL_MM_POOL_MAX   (4)
+
+
 static tlsf_t mem_tlsf;
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
+static pool_t mem_pool[SGL_MM_POOL_MAX];
+static int mem_pool_num = 0;
 
 
 /**
@@ -45,7 +46,8 @@ static sgl_mm_monitor_t mem = {
 void sgl_mm_init(void *mem_start, size_t len)
 {
     mem_tlsf = tlsf_create_with_pool(mem_start, len);
-    mem.total_size += len;
+    mem_pool[mem_pool_num ++] = tlsf_get_pool(mem_tlsf);
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -56,8 +58,15 @@ void sgl_mm_init(void *mem_start, size_t len)
  */
 void sgl_mm_add_pool(void *mem_start, size_t len)
 {
-    tlsf_add_pool(mem_tlsf, mem_start, len);
-    mem.total_size += len;
+    pool_t pool = tlsf_add_pool(mem_tlsf, mem_start, len);
+
+    if (mem_pool_num < SGL_MM_POOL_MAX) {
+        mem_pool[mem_pool_num ++] = pool;
+    }
+    else {
+        SGL_LOG_WARN("sgl_mm_add_pool: the free blocks of pool are not reported");
+    }
+    sgl_mm_stat_add_pool(len);
 }
 
 
@@ -77,7 +86,7 @@ void* sgl_malloc(size_t size)
         return NULL;
     }
 
-    mem.used_size += size;
+    sgl_mm_stat_alloc(tlsf_block_size(ret));
     return ret;
 }
 
@@ -90,13 +99,22 @@ void* sgl_malloc(size_t size)
  */
 void* sgl_realloc(void *p, size_t size)
 {
+    size_t old_size = tlsf_block_size(p);
     void *ret = tlsf_realloc(mem_tlsf, p, size);
+
+    /* the block is freed if size is 0 */
+    if (p != NULL && (ret != NULL || size == 0)) {
+        sgl_mm_stat_free(old_size);
+    }
+
     if(ret == NULL) {
-        SGL_LOG_ERROR("out of memory");
+        if (size != 0) {
+            SGL_LOG_ERROR("out of memory");
+        }
         return NULL;
     }
 
-    mem.used_size += size;
+    sgl_mm_stat_alloc(tlsf_block_size(ret));
 
     return ret;
 }
@@ -111,18 +129,45 @@ void* sgl_realloc(void *p, size_t size)
 */
 void sgl_free(void *p)
 {
-    mem.used_size -= tlsf_block_size(p);
+    if (p == NULL) {
+        return;
+    }
+
+    sgl_mm_stat_free(tlsf_block_size(p));
 
     tlsf_free(mem_tlsf, p);
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+/**
+ * @brief  walker of pool, it finds the free blocks
+ */
+static void sgl_mm_free_walker(void *ptr, size_t size, int used, void *user)
+{
+    size_t *info = (size_t*)user;
+    SGL_UNUSED(ptr);
+
+    if (!used) {
+        info[0] += size;
+        info[1] = sgl_max(info[1], size);
+    }
+}
+
+
+/**
+ * @brief  get free memory info of heap
+ * @param  free_size  output, free size of memory
+ * @param  max_free   output, size of largest free block
+ * @return none
+ */
+void sgl_mm_get_free_info(size_t *free_size, size_t *max_free)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
+    size_t info[2] = {0, 0};
+
+    for (int i = 0; i < mem_pool_num; i++) {
+        tlsf_walk_pool(mem_pool[i], sgl_mm_free_walker, info);
+    }
 
-    return mem;
+    *free_size = info[0];
+    *max_free = info[1];
 }
@@ -55,6 +55,7 @@
 #define CONFIG_SGL_DIRTY_AREA_THRESHOLD 64
 #define CONFIG_SGL_HEAP_ALGO other
 #define CONFIG_SGL_HEAP_MEMORY_SIZE 0
+#define CONFIG_SGL_RENDER_THREADS 0
 
 #define CONFIG_SGL_FBDEV_ROTATION 0
 
@@ -59,32 +59,43 @@ static void sgl_2dball_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
             return;
         }
 
-        int y2 = 0, real_r2 = 0, edge_alpha = 0;
+        int y2 = 0, real_r2 = 0, edge_alpha = 0, inner = 0, edge = 0;
         int r2 = sgl_pow2(obj->radius);
         int r2_edge = sgl_pow2(obj->radius + 1);
         int ds_alpha = SGL_ALPHA_MIN;
+        int seg[3][2];
 
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
         for (int y = clip.y1; y <= clip.y2; y++) {
             y2 = sgl_pow2(y - cy);
-            blend = buf;
-
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                real_r2 = sgl_pow2(x - cx) + y2;
-                ds_alpha = real_r2 * SGL_ALPHA_NUM / r2;
-
-                if (real_r2 >= r2_edge) {
-                    if(x > cx)
-                        break;
-                    continue;
-                }
-                else if (real_r2 >= r2) {
-                    edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                    sgl_color_t color_mix = sgl_color_mixer(ball->bg_color, *blend, edge_alpha);
-                    *blend = sgl_color_mixer(color_mix, *blend, ball->alpha);
-                }
-                else {
-                    *blend = sgl_color_mixer(sgl_color_mixer(ball->bg_color, ball->color, ds_alpha), *blend, ball->alpha);
+            inner = sgl_draw_circle_half(r2, y2);
+            edge = sgl_draw_circle_half(r2_edge, y2);
+
+            /* left edge, inner part and right edge of row, the center is in left edge if no inner part */
+            seg[0][0] = cx - edge;
+            seg[0][1] = cx - inner - 1;
+            seg[1][0] = cx - inner;
+            seg[1][1] = cx + inner;
+            seg[2][0] = cx + sgl_max(inner, 0) + 1;
+            seg[2][1] = cx + edge;
+
+            for (int i = 0; i < 3; i++) {
+                int x1 = sgl_max(seg[i][0], clip.x1);
+                int x2 = sgl_min(seg[i][1], clip.x2);
+                blend = buf + (x1 - clip.x1);
+
+                for (int x = x1; x <= x2; x++, blend++) {
+                    real_r2 = sgl_pow2(x - cx) + y2;
+
+                    if (i == 1) {
+                        ds_alpha = real_r2 * SGL_ALPHA_NUM / r2;
+                        *blend = sgl_color_mixer(sgl_color_mixer(ball->bg_color, ball->color, ds_alpha), *blend, ball->alpha);
+                    }
+                    else {
+                        edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+                        sgl_color_t color_mix = sgl_color_mixer(ball->bg_color, *blend, edge_alpha);
+                        *blend = sgl_color_mixer(color_mix, *blend, ball->alpha);
+                    }
                 }
             }
             buf += surf->w;
@@ -100,7 +111,7 @@ static void sgl_2dball_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_2dball_create(sgl_obj_t* parent)
 {
-    sgl_2dball_t *ball = sgl_malloc(sizeof(sgl_2dball_t));
+    sgl_2dball_t *ball = sgl_slab_alloc(sizeof(sgl_2dball_t));
     if(ball == NULL) {
         SGL_LOG_ERROR("sgl_2dball_create: malloc failed");
         return NULL;
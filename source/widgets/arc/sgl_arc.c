@@ -39,34 +39,34 @@ static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
     int16_t tb_angle = 0;
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        arc->desc.cx = (obj->coords.x2 + obj->coords.x1) / 2;
-        arc->desc.cy = (obj->coords.y2 + obj->coords.y1) / 2;
+        /* draw with a local copy, the object must not be changed while drawing */
+        sgl_draw_arc_t desc = arc->desc;
+        desc.cx = (obj->coords.x2 + obj->coords.x1) / 2;
+        desc.cy = (obj->coords.y2 + obj->coords.y1) / 2;
 
-        if(arc->desc.start_angle == 0 && arc->desc.end_angle == 360) {
-            sgl_draw_fill_ring(surf, &arc->obj.area, arc->desc.cx, arc->desc.cy, arc->desc.radius_in, arc->desc.radius_out, arc->desc.color, arc->desc.alpha);
+        if(desc.start_angle == 0 && desc.end_angle == 360) {
+            sgl_draw_fill_ring(surf, &arc->obj.area, desc.cx, desc.cy, desc.radius_in, desc.radius_out, desc.color, desc.alpha);
         }
         else {
-            sgl_draw_fill_arc(surf, &arc->obj.area, &arc->desc);
+            sgl_draw_fill_arc(surf, &arc->obj.area, &desc);
         }
     }
     else if(evt->type == SGL_EVENT_PRESSED ||
         evt->type == SGL_EVENT_MOVE_DOWN || evt->type == SGL_EVENT_MOVE_UP || evt->type == SGL_EVENT_MOVE_LEFT || evt->type == SGL_EVENT_MOVE_RIGHT
     ) {
+        arc->desc.cx = (obj->coords.x2 + obj->coords.x1) / 2;
+        arc->desc.cy = (obj->coords.y2 + obj->coords.y1) / 2;
         tb_angle = sgl_atan2_angle(evt->pos.x - arc->desc.cx, evt->pos.y - arc->desc.cy);
         tb_angle = 360 - tb_angle;
         if ((tb_angle != arc->desc.end_angle) && tb_angle >= 0 && tb_angle <= 360) {
             arc->desc.end_angle = tb_angle;
         }
 
-        if(obj->event_fn) {
-            obj->event_fn(evt);
-        }
+        sgl_obj_call_event_cb(obj, evt);
         sgl_obj_set_dirty(obj);
     }
     else if(evt->type == SGL_EVENT_RELEASED) {
-        if(obj->event_fn) {
-            obj->event_fn(evt);
-        }
+        sgl_obj_call_event_cb(obj, evt);
     }
     else if(SGL_EVENT_DRAW_INIT) {
         if(arc->desc.radius_out < 0) {
@@ -87,7 +87,7 @@ static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
  */
 sgl_obj_t* sgl_arc_create(sgl_obj_t* parent)
 {
-    sgl_arc_t *arc = sgl_malloc(sizeof(sgl_arc_t));
+    sgl_arc_t *arc = sgl_slab_alloc(sizeof(sgl_arc_t));
     if(arc == NULL) {
         SGL_LOG_ERROR("sgl_arc_create: malloc failed");
         return NULL;
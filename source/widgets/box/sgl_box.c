@@ -34,6 +34,56 @@
 
 #define  SGL_BOX_SCROLL_WIDTH                  (4)
 
+
+/**
+ * @brief scroll the children of box
+ * @param obj point to box object
+ * @param ofs_x: x offset position
+ * @param ofs_y: y offset position
+ * @return none
+ * @note the inner part of a solid background can be copied, the scrollbars are drawn above the
+ *       children, so their tracks are drawn again
+ */
+static void sgl_box_scroll_child(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
+{
+    sgl_box_t *box = (sgl_box_t*)obj;
+    int16_t margin = sgl_max(box->bg.radius, box->bg.border);
+    sgl_area_t view = {
+        .x1 = obj->coords.x1 + margin,
+        .y1 = obj->coords.y1 + margin,
+        .x2 = obj->coords.x2 - margin,
+        .y2 = obj->coords.y2 - margin,
+    };
+    sgl_area_t track;
+
+    if (box->bg.alpha != SGL_ALPHA_MAX || box->bg.pixmap != NULL) {
+        sgl_obj_move_child_pos(obj, ofs_x, ofs_y);
+        sgl_obj_set_dirty(obj);
+        return;
+    }
+
+    sgl_obj_scroll_child_pos(obj, ofs_x, ofs_y, &view);
+
+    if (box->scroll_enable) {
+        track.x1 = obj->coords.x2 - SGL_BOX_SCROLL_WIDTH - box->bg.radius;
+        track.y1 = obj->coords.y1 + box->bg.radius;
+        track.x2 = obj->coords.x2 - box->bg.radius;
+        track.y2 = obj->coords.y2 - box->bg.radius;
+        if (sgl_area_selfclip(&track, &obj->area)) {
+            sgl_obj_update_area(&track);
+        }
+
+        track.x1 = obj->coords.x1 + box->bg.radius;
+        track.y1 = obj->coords.y2 - SGL_BOX_SCROLL_WIDTH - box->bg.radius;
+        track.x2 = obj->coords.x2 - box->bg.radius;
+        track.y2 = obj->coords.y2 - box->bg.radius;
+        if (sgl_area_selfclip(&track, &obj->area)) {
+            sgl_obj_update_area(&track);
+        }
+    }
+}
+
+
 static void sgl_box_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_box_t *box = (sgl_box_t*)obj;
@@ -148,8 +198,7 @@ static void sgl_box_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
             box->y_offset = constrained_new_offset;
 
             // Move all children vertically
-            sgl_obj_move_child_pos_y(obj, offset_delta);
-            sgl_obj_set_dirty(obj);
+            sgl_box_scroll_child(obj, 0, offset_delta);
         }
     }
     else if(evt->type == SGL_EVENT_MOVE_LEFT || evt->type == SGL_EVENT_MOVE_RIGHT) {
@@ -183,8 +232,7 @@ static void sgl_box_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
             box->x_offset = constrained_new_offset;
 
             // Move all children horizontally
-            sgl_obj_move_child_pos_x(obj, offset_delta);
-            sgl_obj_set_dirty(obj);
+            sgl_box_scroll_child(obj, offset_delta, 0);
         }
     }
     else if (evt->type == SGL_EVENT_PRESSED) {
@@ -205,7 +253,7 @@ static void sgl_box_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
  */
 sgl_obj_t* sgl_box_create(sgl_obj_t* parent)
 {
-    sgl_box_t *box = sgl_malloc(sizeof(sgl_box_t));
+    sgl_box_t *box = sgl_slab_alloc(sizeof(sgl_box_t));
     if(box == NULL) {
         SGL_LOG_ERROR("sgl_box_create: malloc failed");
         return NULL;
@@ -230,6 +278,7 @@ sgl_obj_t* sgl_box_create(sgl_obj_t* parent)
     sgl_obj_set_border_width(obj, 1);
     box->bg.border_color = SGL_THEME_BORDER_COLOR;
     box->scroll_color = SGL_THEME_SCROLL_FG_COLOR;
+    sgl_box_update_opaque(obj);
 
     box->x_offset = 0;
     box->y_offset = 0;
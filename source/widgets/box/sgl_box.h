@@ -67,6 +67,25 @@ typedef struct sgl_box {
 sgl_obj_t* sgl_box_create(sgl_obj_t* parent);
 
 
+/**
+ * @brief update the opaque flag of box
+ * @param obj box object
+ * @return none
+ * @note the box is opaque only if its background is full alpha and has no round corner
+ */
+static inline void sgl_box_update_opaque(sgl_obj_t *obj)
+{
+    sgl_box_t *box = (sgl_box_t*)obj;
+
+    if (box->bg.alpha == SGL_ALPHA_MAX && box->bg.radius == 0) {
+        sgl_obj_set_opaque(obj);
+    }
+    else {
+        sgl_obj_clear_opaque(obj);
+    }
+}
+
+
 /**
  * @brief set background color of the box
  * @param obj box object
@@ -91,6 +110,7 @@ static inline void sgl_box_set_radius(sgl_obj_t *obj, uint8_t radius)
     sgl_box_t *box = (sgl_box_t*)obj;
     sgl_obj_set_radius(obj, radius);
     box->bg.radius = obj->radius;
+    sgl_box_update_opaque(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -182,6 +202,7 @@ static inline void sgl_box_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_box_t *box = (sgl_box_t*)obj;
     box->bg.alpha = alpha;
+    sgl_box_update_opaque(obj);
     sgl_obj_set_dirty(obj);
 }
 
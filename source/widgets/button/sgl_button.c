@@ -89,7 +89,7 @@ static void sgl_button_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_button_create(sgl_obj_t* parent)
 {
-    sgl_button_t *button = sgl_malloc(sizeof(sgl_button_t));
+    sgl_button_t *button = sgl_slab_alloc(sizeof(sgl_button_t));
     if(button == NULL) {
         SGL_LOG_ERROR("sgl_button_create: malloc failed");
         return NULL;
@@ -51,7 +51,7 @@ static void sgl_canvas_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_canvas_create(sgl_obj_t* parent)
 {
-    sgl_canvas_t *canvas = sgl_malloc(sizeof(sgl_canvas_t));
+    sgl_canvas_t *canvas = sgl_slab_alloc(sizeof(sgl_canvas_t));
     if(canvas == NULL) {
         SGL_LOG_ERROR("sgl_canvas_create: malloc failed");
         return NULL;
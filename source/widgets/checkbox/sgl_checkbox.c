@@ -160,7 +160,7 @@ static void sgl_checkbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_checkbox_create(sgl_obj_t* parent)
 {
-    sgl_checkbox_t *checkbox = sgl_malloc(sizeof(sgl_checkbox_t));
+    sgl_checkbox_t *checkbox = sgl_slab_alloc(sizeof(sgl_checkbox_t));
     if(checkbox == NULL) {
         SGL_LOG_ERROR("sgl_checkbox_create: malloc failed");
         return NULL;
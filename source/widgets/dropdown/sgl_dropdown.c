@@ -141,6 +141,7 @@ static void sgl_dropdown_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
             obj->coords.y2 += dropdown->expand_h;
         }
 
+        sgl_obj_hit_invalidate();
         sgl_obj_set_dirty(obj);
         dropdown->expend_start = dropdown->head;
     }
@@ -157,7 +158,7 @@ static void sgl_dropdown_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_dropdown_create(sgl_obj_t* parent)
 {
-    sgl_dropdown_t *dropdown = sgl_malloc(sizeof(sgl_dropdown_t));
+    sgl_dropdown_t *dropdown = sgl_slab_alloc(sizeof(sgl_dropdown_t));
     if(dropdown == NULL) {
         SGL_LOG_ERROR("sgl_dropdown_create: malloc failed");
         return NULL;
@@ -32,71 +32,101 @@
 #include <string.h>
 #include "sgl_ext_img.h"
 
-static inline void ext_img_rle_init(sgl_ext_img_t *img)
+
+/* the rows of pixmap in the same format as framebuffer are copied as span without conversion */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) && (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+#define  SGL_EXT_IMG_NATIVE_FMT        SGL_PIXMAP_FMT_RGB565
+#elif (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB888)
+#define  SGL_EXT_IMG_NATIVE_FMT        SGL_PIXMAP_FMT_RGB888
+#else
+#define  SGL_EXT_IMG_NATIVE_FMT        SGL_PIXMAP_FMT_MAX
+#endif
+
+
+/**
+ * @brief reset RLE decompress cursor to the top of pixmap
+ * @param rle RLE decompress cursor
+ * @param pixmap the pixmap that will be decompressed
+ * @return none
+ */
+static inline void ext_img_rle_init(sgl_ext_img_rle_t *rle, const sgl_pixmap_t *pixmap)
 {
-    SGL_ASSERT(img != NULL);
-    img->index = 0;
-    img->remainder = 0;
+    SGL_ASSERT(rle != NULL);
+    rle->pixmap = pixmap;
+    rle->line = 0;
+    rle->index = 0;
+    rle->remainder = 0;
 }
 
-static inline void rle_decompress_line(sgl_ext_img_t *img, sgl_area_t *coords, sgl_area_t *area, sgl_color_t *out)
+
+/**
+ * @brief decompress a line of RLE pixmap and blend it into surface
+ * @param img ext_img object
+ * @param rle RLE decompress cursor
+ * @param coords the area of pixmap
+ * @param area the clip area that will be drawn
+ * @param out surface buffer, NULL means skip the line
+ * @return none
+ */
+static inline void rle_decompress_line(sgl_ext_img_t *img, sgl_ext_img_rle_t *rle, sgl_area_t *coords, sgl_area_t *area, sgl_color_t *out)
 {
     uint8_t tmp_buf[8];
     uint8_t* read_ptr = NULL;
-    uint8_t* start_ptr = (uint8_t*)img->pixmap[img->pixmap_idx].bitmap.array;
-    uint32_t start_addr = img->pixmap[img->pixmap_idx].bitmap.addr;
+    uint8_t* start_ptr = (uint8_t*)rle->pixmap->bitmap.array;
+    uint32_t start_addr = rle->pixmap->bitmap.addr;
     uint8_t format = img->pixmap->format;
     uint32_t pix_value;
+    sgl_color_t color;
 
     for (int i = coords->x1; i <= coords->x2; i++) {
-        if (img->remainder == 0) {
+        if (rle->remainder == 0) {
             if (img->read != NULL) {
                 read_ptr = tmp_buf;
-                img->read(start_addr + img->index, tmp_buf, sizeof(tmp_buf));
+                img->read(start_addr + rle->index, tmp_buf, sizeof(tmp_buf));
             }
             else {
-                read_ptr = start_ptr + img->index;
+                read_ptr = start_ptr + rle->index;
             }
 
-            img->index ++;
-            img->remainder = read_ptr[0];
+            rle->index ++;
+            rle->remainder = read_ptr[0];
 
             switch (format) {
             case SGL_PIXMAP_FMT_RLE_RGB332:
                 pix_value = read_ptr[1];
-                img->color = sgl_rgb332_to_color(pix_value);
-                img->pix_alpha = SGL_ALPHA_MAX;
-                img->index ++;
+                rle->color = sgl_rgb332_to_color(pix_value);
+                rle->pix_alpha = SGL_ALPHA_MAX;
+                rle->index ++;
                 break;
             case SGL_PIXMAP_FMT_RLE_ARGB2222:
                 pix_value = read_ptr[1];
-                img->color = sgl_rgb222_to_color(pix_value);
-                img->pix_alpha = sgl_opa2_table[pix_value >> 6];
-                img->index ++;
+                rle->color = sgl_rgb222_to_color(pix_value);
+                rle->pix_alpha = sgl_opa2_table[pix_value >> 6];
+                rle->index ++;
                 break;
             case SGL_PIXMAP_FMT_RLE_RGB565:
                 pix_value = read_ptr[1] | (read_ptr[2] << 8);
-                img->color = sgl_rgb565_to_color(pix_value);
-                img->pix_alpha = SGL_ALPHA_MAX;
-                img->index += 2;
+                rle->color = sgl_rgb565_to_color(pix_value);
+                rle->pix_alpha = SGL_ALPHA_MAX;
+                rle->index += 2;
                 break;
             case SGL_PIXMAP_FMT_RLE_ARGB4444:
                 pix_value = read_ptr[1] | (read_ptr[2] << 8);
-                img->color = sgl_rgb444_to_color(pix_value);
-                img->pix_alpha = sgl_opa4_table[pix_value >> 12];
-                img->index += 2;
+                rle->color = sgl_rgb444_to_color(pix_value);
+                rle->pix_alpha = sgl_opa4_table[pix_value >> 12];
+                rle->index += 2;
                 break;
             case SGL_PIXMAP_FMT_RLE_RGB888:
                 pix_value = read_ptr[1] | (read_ptr[2] << 8) | (read_ptr[3] << 16);
-                img->color = sgl_rgb888_to_color(pix_value);
-                img->pix_alpha = SGL_ALPHA_MAX;
-                img->index += 3;
+                rle->color = sgl_rgb888_to_color(pix_value);
+                rle->pix_alpha = SGL_ALPHA_MAX;
+                rle->index += 3;
                 break;
             case SGL_PIXMAP_FMT_RLE_ARGB8888:
                 pix_value = read_ptr[1] | (read_ptr[2] << 8) | (read_ptr[3] << 16);
-                img->color = sgl_rgb888_to_color(pix_value);
-                img->pix_alpha = read_ptr[4];
-                img->index += 4;
+                rle->color = sgl_rgb888_to_color(pix_value);
+                rle->pix_alpha = read_ptr[4];
+                rle->index += 4;
                 break;
             default:
                 break;
@@ -104,12 +134,14 @@ static inline void rle_decompress_line(sgl_ext_img_t *img, sgl_area_t *coords, s
         }
 
         if (out != NULL && i >= area->x1 && i <= area->x2) {
-            img->color = (img->pix_alpha == SGL_ALPHA_MAX ? img->color : sgl_color_mixer(img->color, *out, img->pix_alpha));
-            *out = (img->alpha == SGL_ALPHA_MAX ? img->color : sgl_color_mixer(img->color, *out, img->alpha));
+            color = (rle->pix_alpha == SGL_ALPHA_MAX ? rle->color : sgl_color_mixer(rle->color, *out, rle->pix_alpha));
+            *out = (img->alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *out, img->alpha));
             out ++;
         }
-        img->remainder --;
+        rle->remainder --;
     };
+
+    rle->line ++;
 }
 
 
@@ -141,7 +173,7 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
 
             uint8_t *pixmap_buf = (uint8_t*)pixmap->bitmap.array;
             if(ext_img->read != NULL){
-                pixmap_buf = (uint8_t*)sgl_malloc(pix_byte * (clip.x2 - clip.x1 + 1));
+                pixmap_buf = (uint8_t*)sgl_scratch_alloc(pix_byte * (clip.x2 - clip.x1 + 1));
             }
 
             for (int y = clip.y1; y <= clip.y2; y++) {
@@ -151,6 +183,11 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
                     ext_img->read(read_addr + offset, pixmap_buf, pix_byte * (clip.x2 - clip.x1 + 1));
                     offset = 0;
                 }
+                if (pixmap->format == SGL_EXT_IMG_NATIVE_FMT && ((uintptr_t)(pixmap_buf + offset) % sizeof(sgl_color_t)) == 0) {
+                    sgl_span_copy(blend, (const sgl_color_t*)(pixmap_buf + offset), ext_img->alpha, clip.x2 - clip.x1 + 1);
+                    buf += surf->w;
+                    continue;
+                }
                 for (int x = clip.x1; x <= clip.x2; x++) {
                     switch (pixmap->format) {
                     case SGL_PIXMAP_FMT_RGB332:
@@ -190,30 +227,46 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
                 buf += surf->w;
             }
             if(ext_img->read != NULL) {
-                sgl_free(pixmap_buf);
+                sgl_scratch_free(pixmap_buf);
             }
         }
         else {
             /* RLE pixmap support */
-            if (clip.y1 == surf->dirty->y1 || clip.y1 == obj->area.y1) {
-                ext_img->index = 0;
-                ext_img->remainder = 0;
-                for (int y = area.y1; y < clip.y1; y++) {
-                    rle_decompress_line(ext_img, &area, &clip, NULL);
-                }
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+            /* bands are drawn in parallel, every band decompresses with its own cursor */
+            sgl_ext_img_rle_t *rle = &ext_img->rle[surf->band];
+#else
+            sgl_ext_img_rle_t *rle = &ext_img->rle;
+#endif
+            /* continue from previous slice if possible, otherwise restart from the top of pixmap */
+            if (rle->pixmap != pixmap || rle->line > clip.y1 - area.y1) {
+                ext_img_rle_init(rle, pixmap);
+            }
+            for (int y = area.y1 + rle->line; y < clip.y1; y++) {
+                rle_decompress_line(ext_img, rle, &area, &clip, NULL);
             }
 
             buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, (clip.y1 - surf->y1));
 
             for (int y = clip.y1; y <= clip.y2; y++) {
-                rle_decompress_line(ext_img, &area, &clip, buf);
+                rle_decompress_line(ext_img, rle, &area, &clip, buf);
                 buf += surf->w;
             }
         }
-
-        if (ext_img->pixmap_auto && (clip.y2 == surf->dirty->y2 || clip.y2 == obj->area.y2)) {
+    }
+    else if (evt->type == SGL_EVENT_DRAW_INIT) {
+        /* the init is called before the frame is drawn, so the pixmap never changes while drawing,
+         * and the drawing does not write the object, it may be drawn by several render threads */
+        if (ext_img->pixmap_next) {
             uint32_t pixmap_idx = ext_img->pixmap_idx + 1;
             ext_img->pixmap_idx = pixmap_idx >= ext_img->pixmap_num ? 0 : pixmap_idx;
+            ext_img->pixmap_next = 0;
+        }
+
+        /* draw the current pixmap in this frame and switch to next one in next frame */
+        if (ext_img->pixmap_auto) {
+            ext_img->pixmap_next = 1;
+            sgl_obj_needinit(obj);
             sgl_obj_set_dirty(obj);
         }
     }
@@ -227,7 +280,7 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
  */
 sgl_obj_t* sgl_ext_img_create(sgl_obj_t* parent)
 {
-    sgl_ext_img_t *ext_img = sgl_malloc(sizeof(sgl_ext_img_t));
+    sgl_ext_img_t *ext_img = sgl_slab_alloc(sizeof(sgl_ext_img_t));
     if(ext_img == NULL) {
         SGL_LOG_ERROR("sgl_ext_img_create: malloc failed");
         return NULL;
@@ -108,6 +108,25 @@
  */
 
 
+/**
+ * @brief RLE decompress cursor of ext_img
+ * @pixmap: the pixmap that is being decompressed
+ * @line: the next line to decompress, relative to the top of pixmap
+ * @index: the read index of pixmap bitmap
+ * @color: the color of current run
+ * @remainder: the remaining pixels of current run
+ * @pix_alpha: the alpha of current run
+ */
+typedef struct sgl_ext_img_rle {
+    const sgl_pixmap_t *pixmap;
+    int32_t         line;
+    uint32_t        index;
+    sgl_color_t     color;
+    uint8_t         remainder;
+    uint8_t         pix_alpha;
+} sgl_ext_img_rle_t;
+
+
 /**
  * @brief sgl ext_img struct
  * @obj: sgl general object
@@ -121,11 +140,14 @@ typedef struct sgl_ext_img {
     uint8_t         pixmap_auto;
     uint8_t         pixmap_idx;
     uint8_t         pixmap_num;
-    /* RLE compress context */
-    sgl_color_t     color;
-    uint8_t         remainder;
-    uint8_t         pix_alpha;
-    uint32_t        index;
+    uint8_t         pixmap_next;
+#if (CONFIG_SGL_RENDER_THREADS > 1)
+    /* RLE decompress cursor of every render band, it is kept to continue decompressing in next slice */
+    sgl_ext_img_rle_t rle[CONFIG_SGL_RENDER_THREADS];
+#else
+    /* RLE decompress cursor, it is kept to continue decompressing in next slice */
+    sgl_ext_img_rle_t rle;
+#endif
 #if CONFIG_SGL_EXT_IMG_USE_BUFFER
     uint8_t         flash_buffer[512];
 #endif
@@ -189,6 +211,11 @@ static inline void sgl_ext_img_set_pixmap_num(sgl_obj_t *obj, uint8_t num, bool
     SGL_ASSERT(obj != NULL);
     ((sgl_ext_img_t*)obj)->pixmap_num = num;
     ((sgl_ext_img_t*)obj)->pixmap_auto = (uint8_t)auto_refresh;
+
+    /* the auto refresh is driven by the init of every frame */
+    if (auto_refresh) {
+        sgl_obj_needinit(obj);
+    }
 }
 
 /**
@@ -59,7 +59,7 @@ static void sgl_icon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_icon_create(sgl_obj_t* parent)
 {
-    sgl_icon_t *icon = sgl_malloc(sizeof(sgl_icon_t));
+    sgl_icon_t *icon = sgl_slab_alloc(sizeof(sgl_icon_t));
     if(icon == NULL) {
         SGL_LOG_ERROR("sgl_icon_create: malloc failed");
         return NULL;
@@ -509,7 +509,7 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_keyboard_create(sgl_obj_t* parent)
 {
-    sgl_keyboard_t *keyboard = sgl_malloc(sizeof(sgl_keyboard_t));
+    sgl_keyboard_t *keyboard = sgl_slab_alloc(sizeof(sgl_keyboard_t));
     if(keyboard == NULL) {
         SGL_LOG_ERROR("sgl_keyboard_create: malloc failed");
         return NULL;
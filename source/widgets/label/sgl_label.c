@@ -109,7 +109,7 @@ static void sgl_draw_rotated_string(sgl_surf_t *surf, sgl_area_t *area, int16_t
         return;
     }
     
-    sgl_color_t *temp_buf = sgl_malloc(buf_size * sizeof(sgl_color_t));
+    sgl_color_t *temp_buf = sgl_scratch_alloc(buf_size * sizeof(sgl_color_t));
     if (!temp_buf) {
         // 如果分配失败，回退到普通绘制
         sgl_draw_string(surf, area, x, y, str, color, alpha, font);
@@ -193,7 +193,7 @@ static void sgl_draw_rotated_string(sgl_surf_t *surf, sgl_area_t *area, int16_t
     }
     
     // 释放临时缓冲区
-    sgl_free(temp_buf);
+    sgl_scratch_free(temp_buf);
 }
 
 
@@ -243,7 +243,7 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_label_create(sgl_obj_t* parent)
 {
-    sgl_label_t *label = sgl_malloc(sizeof(sgl_label_t));
+    sgl_label_t *label = sgl_slab_alloc(sizeof(sgl_label_t));
     if(label == NULL) {
         SGL_LOG_ERROR("sgl_label_create: malloc failed");
         return NULL;
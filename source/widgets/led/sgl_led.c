@@ -97,9 +97,7 @@ static void sgl_led_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
         }
     }
     else if (evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_RELEASED) {
-        if (obj->event_fn) {
-            obj->event_fn(evt);
-        }
+        sgl_obj_call_event_cb(obj, evt);
     }
 }
 
@@ -111,7 +109,7 @@ static void sgl_led_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
  */
 sgl_obj_t* sgl_led_create(sgl_obj_t* parent)
 {
-    sgl_led_t *led = sgl_malloc(sizeof(sgl_led_t));
+    sgl_led_t *led = sgl_slab_alloc(sizeof(sgl_led_t));
     if(led == NULL) {
         SGL_LOG_ERROR("sgl_led_create: malloc failed");
         return NULL;
@@ -50,7 +50,7 @@ static void sgl_line_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_line_create(sgl_obj_t* parent)
 {
-    sgl_line_t *line = sgl_malloc(sizeof(sgl_line_t));
+    sgl_line_t *line = sgl_slab_alloc(sizeof(sgl_line_t));
     if(line == NULL) {
         SGL_LOG_ERROR("sgl_line_create: malloc failed");
         return NULL;
@@ -84,6 +84,8 @@ void sgl_line_set_pos(sgl_obj_t *obj, int16_t x1, int16_t y1, int16_t x2, int16_
     int16_t _x1, _y1, _x2, _y2;
 	sgl_line_t *line = (sgl_line_t*)obj;
 
+    /* the parent may be moved by the pending translation of its ancestors */
+    sgl_obj_coords_sync(obj);
     _x1 = obj->parent->coords.x1 + x1;
     _x2 = obj->parent->coords.x1 + x2;
     _y1 = obj->parent->coords.y1 + y1;
@@ -103,5 +105,6 @@ void sgl_line_set_pos(sgl_obj_t *obj, int16_t x1, int16_t y1, int16_t x2, int16_
 	obj->coords.y2 = _y2;
 	line->desc.width = 2;
 
+    sgl_obj_hit_invalidate();
 	sgl_obj_set_dirty(obj);
 }
@@ -103,5 +103,19 @@ static inline void sgl_line_set_width(sgl_obj_t *obj, uint8_t width)
 	sgl_obj_set_dirty(obj);
 }
 
+/**
+ * @brief set line cap
+ * @param obj line object
+ * @param cap SGL_LINE_CAP_ROUND or SGL_LINE_CAP_FLAT
+ * @return none
+ */
+static inline void sgl_line_set_cap(sgl_obj_t *obj, uint8_t cap)
+{
+	SGL_ASSERT(obj != NULL);
+	sgl_line_t *line = (sgl_line_t*)obj;
+	line->desc.cap = cap;
+	sgl_obj_set_dirty(obj);
+}
+
 
 #endif // !__SGL_LINE_H__
@@ -187,7 +187,7 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_msgbox_create(sgl_obj_t* parent)
 {
-    sgl_msgbox_t *msgbox = sgl_malloc(sizeof(sgl_msgbox_t));
+    sgl_msgbox_t *msgbox = sgl_slab_alloc(sizeof(sgl_msgbox_t));
     if(msgbox == NULL) {
         SGL_LOG_ERROR("sgl_msgbox_create: malloc failed");
         return NULL;
@@ -238,7 +238,7 @@ static void sgl_numberkbd_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
  */
 sgl_obj_t* sgl_numberkbd_create(sgl_obj_t* parent)
 {
-    sgl_numberkbd_t *numberkbd = sgl_malloc(sizeof(sgl_numberkbd_t));
+    sgl_numberkbd_t *numberkbd = sgl_slab_alloc(sizeof(sgl_numberkbd_t));
     if(numberkbd == NULL) {
         SGL_LOG_ERROR("sgl_numberkbd_create: malloc failed");
         return NULL;
@@ -156,7 +156,7 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
 // Create polygon object
 sgl_obj_t* sgl_polygon_create(sgl_obj_t* parent)
 {
-    sgl_polygon_t *polygon = (sgl_polygon_t*)sgl_malloc(sizeof(sgl_polygon_t));
+    sgl_polygon_t *polygon = (sgl_polygon_t*)sgl_slab_alloc(sizeof(sgl_polygon_t));
     if (polygon == NULL) {
         return NULL;
     }
@@ -70,7 +70,7 @@ static void sgl_progress_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_progress_create(sgl_obj_t* parent)
 {
-    sgl_progress_t *progress = sgl_malloc(sizeof(sgl_progress_t));
+    sgl_progress_t *progress = sgl_slab_alloc(sizeof(sgl_progress_t));
     if(progress == NULL) {
         SGL_LOG_ERROR("sgl_progress_create: malloc failed");
         return NULL;
@@ -78,7 +78,7 @@ static void sgl_rectangle_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
  */
 sgl_obj_t* sgl_rect_create(sgl_obj_t* parent)
 {
-    sgl_rectangle_t *rect = sgl_malloc(sizeof(sgl_rectangle_t));
+    sgl_rectangle_t *rect = sgl_slab_alloc(sizeof(sgl_rectangle_t));
     if(rect == NULL) {
         SGL_LOG_ERROR("sgl_rect_create: malloc failed");
         return NULL;
@@ -98,6 +98,7 @@ sgl_obj_t* sgl_rect_create(sgl_obj_t* parent)
     rect->color = SGL_THEME_COLOR;
     rect->border_color = SGL_THEME_BORDER_COLOR;
     rect->pixmap = NULL;
+    sgl_rect_update_opaque(obj);
 
     return obj;
 }
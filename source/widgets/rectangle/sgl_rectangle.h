@@ -56,6 +56,26 @@ typedef struct sgl_rectangle {
 sgl_obj_t* sgl_rect_create(sgl_obj_t* parent);
 
 
+/**
+ * @brief update the opaque flag of rectangle
+ * @param obj rectangle object
+ * @return none
+ * @note the rectangle is opaque only if it is full alpha, the round corner of object
+ *       is checked by sgl_obj_is_opaque
+ */
+static inline void sgl_rect_update_opaque(sgl_obj_t *obj)
+{
+    sgl_rectangle_t *rect = (sgl_rectangle_t *)obj;
+
+    if (rect->alpha == SGL_ALPHA_MAX) {
+        sgl_obj_set_opaque(obj);
+    }
+    else {
+        sgl_obj_clear_opaque(obj);
+    }
+}
+
+
 /**
  * @brief  set rectangle color
  * @param  obj: rectangle object
@@ -79,6 +99,7 @@ static inline void sgl_rect_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_rectangle_t *rect = (sgl_rectangle_t *)obj;
     rect->alpha = alpha;
+    sgl_rect_update_opaque(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -91,6 +112,7 @@ static inline void sgl_rect_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 static inline void sgl_rect_set_radius(sgl_obj_t *obj, uint8_t radius)
 {
     sgl_obj_set_radius(obj, radius);
+    sgl_rect_update_opaque(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -62,7 +62,7 @@ static void sgl_ring_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_ring_create(sgl_obj_t* parent)
 {
-    sgl_ring_t *ring = sgl_malloc(sizeof(sgl_ring_t));
+    sgl_ring_t *ring = sgl_slab_alloc(sizeof(sgl_ring_t));
     if(ring == NULL) {
         SGL_LOG_ERROR("sgl_ring_create: malloc failed");
         return NULL;
@@ -353,7 +353,7 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
 // Create an oscilloscope object
 sgl_obj_t* sgl_scope_create(sgl_obj_t* parent)
 {
-    sgl_scope_t *scope = sgl_malloc(sizeof(sgl_scope_t));
+    sgl_scope_t *scope = sgl_slab_alloc(sizeof(sgl_scope_t));
     if(scope == NULL) {
         return NULL;
     }
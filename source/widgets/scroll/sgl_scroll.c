@@ -124,7 +124,7 @@ static void sgl_scroll_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_scroll_create(sgl_obj_t* parent)
 {
-    sgl_scroll_t *scroll = sgl_malloc(sizeof(sgl_scroll_t));
+    sgl_scroll_t *scroll = sgl_slab_alloc(sizeof(sgl_scroll_t));
     if(scroll == NULL) {
         SGL_LOG_ERROR("sgl_scroll_create: malloc failed");
         return NULL;
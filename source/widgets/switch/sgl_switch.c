@@ -80,7 +80,7 @@ static void sgl_switch_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_switch_create(sgl_obj_t* parent)
 {
-    sgl_switch_t *p_switch = sgl_malloc(sizeof(sgl_switch_t));
+    sgl_switch_t *p_switch = sgl_slab_alloc(sizeof(sgl_switch_t));
     if(p_switch == NULL) {
         SGL_LOG_ERROR("sgl_switch_create: malloc failed");
         return NULL;
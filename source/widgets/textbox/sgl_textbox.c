@@ -116,7 +116,7 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
  */
 sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent)
 {
-    sgl_textbox_t *textbox = sgl_malloc(sizeof(sgl_textbox_t));
+    sgl_textbox_t *textbox = sgl_slab_alloc(sizeof(sgl_textbox_t));
     if(textbox == NULL) {
         SGL_LOG_ERROR("sgl_textbox_create: malloc failed");
         return NULL;
@@ -63,7 +63,7 @@ static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_textline_create(sgl_obj_t* parent)
 {
-    sgl_textline_t *textline = sgl_malloc(sizeof(sgl_textline_t));
+    sgl_textline_t *textline = sgl_slab_alloc(sizeof(sgl_textline_t));
     if(textline == NULL) {
         SGL_LOG_ERROR("sgl_textline_create: malloc failed");
         return NULL;
@@ -203,9 +203,7 @@ static void sgl_unzip_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
         }
     }
     else if (evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_RELEASED) {
-        if (obj->event_fn) {
-            obj->event_fn(evt);
-        }
+        sgl_obj_call_event_cb(obj, evt);
     }
 }
 
@@ -216,7 +214,7 @@ static void sgl_unzip_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
  */
 sgl_obj_t* sgl_unzip_img_create(sgl_obj_t* parent)
 {
-    sgl_unzip_img_t *unzip_img = sgl_malloc(sizeof(sgl_unzip_img_t));
+    sgl_unzip_img_t *unzip_img = sgl_slab_alloc(sizeof(sgl_unzip_img_t));
     if (unzip_img == NULL) {
         SGL_LOG_ERROR("sgl_unzip_img_create: malloc failed");
         return NULL;